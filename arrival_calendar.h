@@ -0,0 +1,82 @@
+#ifndef ARRIVAL_CALENDAR_H
+#define ARRIVAL_CALENDAR_H
+
+#include <algorithm>
+#include <vector>
+
+#include "process_table.h"
+
+using namespace std;
+
+/**
+ * Index of when every process arrives, built once per workload
+ * Processes are ordered by arrival time (ties keep their order in the table), and their arrival times are
+ * stored next to them, so the simulator finds the processes arriving at a time step and the time of the next
+ * arrival by advancing a cursor, without scanning or even touching the rest of the table
+ * The calendar only reads the table, so every simulation of the same workload can share one
+ */
+class ArrivalCalendar {
+
+public:
+
+    /**
+     * Builds the calendar for a table of processes
+     * Workloads that are already in order of arrival (such as binary workloads) take a single pass
+     * Processes with a negative arrival time never arrive, so they are left out
+     * @param processes The table of processes
+     */
+    explicit ArrivalCalendar(const ProcessTable& processes) {
+
+        for(unsigned int i = 0; i < processes.size(); i++) {
+            if(processes.arrivalTime[i] >= 0) {
+                order.push_back(i);
+            }
+        }
+
+        bool sorted = true;
+        for(unsigned int position = 1; position < order.size() && sorted; position++) {
+            sorted = processes.arrivalTime[order[position - 1]] <= processes.arrivalTime[order[position]];
+        }
+        if(!sorted) {
+            stable_sort(order.begin(), order.end(), [&processes](int a, int b) {
+                return processes.arrivalTime[a] < processes.arrivalTime[b];
+            });
+        }
+
+        times.resize(order.size());
+        for(unsigned int position = 0; position < order.size(); position++) {
+            times[position] = processes.arrivalTime[order[position]];
+        }
+    }
+
+    /**
+     * @return The number of processes that arrive
+     */
+    unsigned int size() const {
+        return order.size();
+    }
+
+    /**
+     * @param position A position in the calendar, counting from the earliest arrival
+     * @return The index of the process at that position
+     */
+    int processAt(unsigned int position) const {
+        return order[position];
+    }
+
+    /**
+     * @param position A position in the calendar, counting from the earliest arrival
+     * @return The arrival time of the process at that position
+     */
+    int timeAt(unsigned int position) const {
+        return times[position];
+    }
+
+private:
+
+    vector<int> order;  // indices of the processes sorted by arrival time
+    vector<int> times;  // the arrival time of each process in order
+
+};
+
+#endif //ARRIVAL_CALENDAR_H
@@ -0,0 +1,344 @@
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+#include "binary_workload.h"
+
+using namespace std;
+
+/**
+ * @param offset A byte offset
+ * @return The offset rounded up to the next 8-byte boundary
+ */
+static uint64_t alignSection(uint64_t offset) {
+    return (offset + 7) & ~static_cast<uint64_t>(7);
+}
+
+/**
+ * @param processType A process type
+ * @return The number of int32 columns that only the given process type has
+ */
+static unsigned int numTypeColumns(ProcessType processType) {
+    return processType == INTERACTIVE ? 1 : processType == REALTIME ? 2 : 0;
+}
+
+/**
+ * @return Whether this machine stores numbers in little-endian byte order, like the file does
+ */
+static bool isLittleEndian() {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+/**
+ * Print an error about a binary workload file and terminate the program
+ * @param filename The name of the file
+ * @param message A description of the problem
+ */
+[[noreturn]] static void binaryWorkloadError(const string& filename, const string& message) {
+    cerr << "\"" << filename << "\" is not a valid binary workload: " << message << ", terminating program" << endl;
+    exit(-1);
+}
+
+/**
+ * Append a varint (7 bits per byte, low bits first) to a buffer
+ * @param buffer The buffer to append to
+ * @param value The number to encode
+ */
+static void writeVarint(string& buffer, uint64_t value) {
+    while(value >= 0x80) {
+        buffer += static_cast<char>((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    buffer += static_cast<char>(value);
+}
+
+/**
+ * Decode a varint written by writeVarint
+ * @param position The first byte of the varint; moved past it if it is valid
+ * @param end One past the last byte that may be read
+ * @param value Set to the decoded number
+ * @return Whether a complete varint was found
+ */
+static bool readVarint(const unsigned char*& position, const unsigned char* end, uint64_t& value) {
+    value = 0;
+    for(unsigned int shift = 0; position != end && shift < 64; shift += 7) {
+        value |= static_cast<uint64_t>(*position & 0x7f) << shift;
+        if(!(*position++ & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Compute where each section of a binary workload file starts
+ * @param header The header of the file
+ * @return The offsets of the sections
+ */
+BinaryWorkloadLayout binaryWorkloadLayout(const BinaryWorkloadHeader& header) {
+
+    BinaryWorkloadLayout layout;
+    uint64_t columnBytes = alignSection(header.numProcesses * sizeof(int32_t));
+    bool hasIdIndices = !(header.flags & BINARY_WORKLOAD_DISTINCT_IDS);
+
+    layout.computationTimes = alignSection(sizeof(BinaryWorkloadHeader));
+    layout.typeColumns = layout.computationTimes + columnBytes;
+    layout.idIndices = layout.typeColumns + columnBytes * numTypeColumns(static_cast<ProcessType>(header.processType));
+    layout.idText = layout.idIndices + (hasIdIndices ? columnBytes : 0);
+    layout.idLengths = layout.idText + header.idTextLength;
+    layout.arrivalTimes = layout.idLengths + header.idLengthsLength;
+    layout.end = layout.arrivalTimes + header.arrivalLength;
+
+    return layout;
+}
+
+/**
+ * @param begin The first byte of a file
+ * @param end One past the last byte of the file
+ * @return Whether the file starts like a binary workload file
+ */
+bool isBinaryWorkload(const char* begin, const char* end) {
+    return end - begin >= 4 && memcmp(begin, BINARY_WORKLOAD_MAGIC, 4) == 0;
+}
+
+/**
+ * Load the processes from a binary workload file that is already in memory
+ * The fixed-width columns are copied in bulk without parsing, so loading is bound by memory bandwidth
+ * @param filename The name of the file, for error messages
+ * @param begin The first byte of the file
+ * @param end One past the last byte of the file
+ * @param processType The type of processes expected, or NONE to accept the type stored in the file
+ * @param processes The table representation of all the processes
+ * @post processes is filled with the processes from the file
+ */
+void readBinaryWorkload(const string& filename, const char* begin, const char* end, ProcessType processType, ProcessTable& processes) {
+
+    BinaryWorkloadHeader header;
+    uint64_t fileSize = end - begin;
+
+    if(!isLittleEndian()) {
+        binaryWorkloadError(filename, "binary workloads can only be read on little-endian machines");
+    }
+    if(fileSize < sizeof(header)) {
+        binaryWorkloadError(filename, "the header is truncated");
+    }
+    memcpy(&header, begin, sizeof(header));
+
+    if(header.version != BINARY_WORKLOAD_VERSION) {
+        binaryWorkloadError(filename, "unsupported version " + to_string(header.version));
+    }
+    ProcessType fileType = static_cast<ProcessType>(header.processType);
+    if(fileType != BATCH && fileType != INTERACTIVE && fileType != REALTIME) {
+        binaryWorkloadError(filename, "unknown process type " + to_string(header.processType));
+    }
+    if(processType != NONE && processType != fileType) {
+        binaryWorkloadError(filename, "the file holds a different type of process than the one selected");
+    }
+    // every id length is a varint of at least one byte, and the offsets of the ids need one more entry than them
+    if(header.numProcesses > UINT_MAX || header.numIds >= UINT_MAX || header.idTextLength > fileSize
+            || header.idLengthsLength > fileSize || header.numIds > header.idLengthsLength || header.arrivalLength > fileSize
+            || binaryWorkloadLayout(header).end != fileSize) {
+        binaryWorkloadError(filename, "the section sizes do not match the size of the file");
+    }
+    if((header.flags & BINARY_WORKLOAD_DISTINCT_IDS) && header.numIds != header.numProcesses) {
+        binaryWorkloadError(filename, "the number of ids does not match the number of processes");
+    }
+
+    BinaryWorkloadLayout layout = binaryWorkloadLayout(header);
+    unsigned int numProcesses = header.numProcesses;
+    unsigned int numIds = header.numIds;
+    size_t columnBytes = numProcesses * sizeof(int32_t);
+
+    processes = ProcessTable(fileType);
+    processes.resize(numProcesses);
+
+    // Fixed-width columns
+    memcpy(processes.totalTimeNeeded.data(), begin + layout.computationTimes, columnBytes);
+    if(fileType == INTERACTIVE) {
+        memcpy(processes.priority.data(), begin + layout.typeColumns, columnBytes);
+    } else if(fileType == REALTIME) {
+        memcpy(processes.period.data(), begin + layout.typeColumns, columnBytes);
+        memcpy(processes.deadline.data(), begin + layout.typeColumns + alignSection(columnBytes), columnBytes);
+    }
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        if(processes.totalTimeNeeded[i] < 1) {
+            binaryWorkloadError(filename, "the computation time of process " + to_string(i) + " is less than 1");
+        }
+    }
+
+    if(header.flags & BINARY_WORKLOAD_DISTINCT_IDS) {
+        iota(processes.idIndex.begin(), processes.idIndex.end(), 0);
+    } else {
+        memcpy(processes.idIndex.data(), begin + layout.idIndices, columnBytes);
+        for(unsigned int i = 0; i < numProcesses; i++) {
+            if(processes.idIndex[i] >= numIds) {
+                binaryWorkloadError(filename, "process " + to_string(i) + " refers to a missing id");
+            }
+        }
+    }
+
+    // Id table
+    processes.ids.text.assign(begin + layout.idText, header.idTextLength);
+    processes.ids.offsets.resize(numIds + 1);
+    const unsigned char* position = reinterpret_cast<const unsigned char*>(begin + layout.idLengths);
+    const unsigned char* sectionEnd = reinterpret_cast<const unsigned char*>(begin + layout.arrivalTimes);
+    for(unsigned int i = 0; i < numIds; i++) {
+        uint64_t length;
+        if(!readVarint(position, sectionEnd, length) || length > header.idTextLength - processes.ids.offsets[i]) {
+            binaryWorkloadError(filename, "the id table is corrupt");
+        }
+        processes.ids.offsets[i + 1] = processes.ids.offsets[i] + length;
+    }
+    if(position != sectionEnd || processes.ids.offsets[numIds] != header.idTextLength) {
+        binaryWorkloadError(filename, "the id table is corrupt");
+    }
+
+    // Arrival times, stored as zigzag varint deltas
+    sectionEnd = reinterpret_cast<const unsigned char*>(end);
+    int64_t arrivalTime = 0;
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        uint64_t encoded;
+        if(!readVarint(position, sectionEnd, encoded)) {
+            binaryWorkloadError(filename, "the arrival times are truncated");
+        }
+        arrivalTime += static_cast<int64_t>(encoded >> 1) ^ -static_cast<int64_t>(encoded & 1);
+        if(arrivalTime < 0 || arrivalTime > INT_MAX) {
+            binaryWorkloadError(filename, "the arrival time of process " + to_string(i) + " is negative or too large");
+        }
+        processes.arrivalTime[i] = static_cast<int>(arrivalTime);
+    }
+    if(position != sectionEnd) {
+        binaryWorkloadError(filename, "the file has data after the arrival times");
+    }
+}
+
+/**
+ * Write a table of processes to a binary workload file
+ * Processes are stored in order of arrival; a table in another order is sorted first, keeping the order of
+ * processes that arrive at the same time
+ * @param filename The name of the file to write to
+ * @param processes The processes to write
+ */
+void writeBinaryWorkload(const string& filename, const ProcessTable& processes) {
+
+    ProcessType processType = processes.processType;
+    unsigned int numProcesses = processes.size();
+
+    if(processType != BATCH && processType != INTERACTIVE && processType != REALTIME) {
+        cerr << "Invalid process type supplied: " << processType << endl;
+        exit(-1);
+    }
+    if(!isLittleEndian()) {
+        cerr << "Binary workloads can only be written on little-endian machines" << endl;
+        exit(-1);
+    }
+
+    vector<unsigned int> order(numProcesses);
+    iota(order.begin(), order.end(), 0);
+    if(!is_sorted(processes.arrivalTime.begin(), processes.arrivalTime.end())) {
+        cerr << "Note: storing the processes in order of arrival, so ties may be broken differently" << endl;
+        stable_sort(order.begin(), order.end(), [&processes](unsigned int a, unsigned int b) {
+            return processes.arrivalTime[a] < processes.arrivalTime[b];
+        });
+    }
+
+    // Intern the ids so every distinct id is stored once
+    // The lookup is an open-addressing hash table whose slots hold an id index plus 1, or 0 when empty
+    IdTable ids;
+    ids.text.reserve(processes.ids.text.size());
+    ids.offsets.reserve(processes.ids.offsets.size());
+    vector<uint32_t> idIndices(numProcesses);
+    size_t numSlots = 1;
+    while(numSlots < 2 * static_cast<size_t>(numProcesses)) {
+        numSlots *= 2;
+    }
+    vector<uint32_t> idLookup(numSlots, 0);
+    bool distinctIds = true;
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        string_view id = processes.getId(order[i]);
+        size_t slot = hash<string_view>()(id) & (numSlots - 1);
+        while(idLookup[slot] != 0 && ids[idLookup[slot] - 1] != id) {
+            slot = (slot + 1) & (numSlots - 1);
+        }
+        if(idLookup[slot] == 0) {
+            idLookup[slot] = ids.add(id) + 1;
+        }
+        idIndices[i] = idLookup[slot] - 1;
+        distinctIds = distinctIds && idIndices[i] == i;
+    }
+
+    string idLengths;
+    for(unsigned int i = 0; i < ids.size(); i++) {
+        writeVarint(idLengths, ids.offsets[i + 1] - ids.offsets[i]);
+    }
+
+    // Encode the arrival times as zigzag deltas
+    string arrivals;
+    int64_t previousArrival = 0;
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        int64_t delta = processes.arrivalTime[order[i]] - previousArrival;
+        writeVarint(arrivals, (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63));
+        previousArrival = processes.arrivalTime[order[i]];
+    }
+
+    BinaryWorkloadHeader header;
+    memcpy(header.magic, BINARY_WORKLOAD_MAGIC, 4);
+    header.version = BINARY_WORKLOAD_VERSION;
+    header.processType = processType;
+    header.flags = distinctIds ? BINARY_WORKLOAD_DISTINCT_IDS : 0;
+    header.numProcesses = numProcesses;
+    header.numIds = ids.size();
+    header.idTextLength = ids.text.size();
+    header.idLengthsLength = idLengths.size();
+    header.arrivalLength = arrivals.size();
+    BinaryWorkloadLayout layout = binaryWorkloadLayout(header);
+
+    ofstream out(filename.c_str(), ios::binary);
+    if(out.fail()) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    uint64_t written = 0;
+    auto writeSection = [&](uint64_t offset, const void* data, uint64_t length) {
+        static const char padding[8] = {0};
+        out.write(padding, offset - written);
+        out.write(static_cast<const char*>(data), length);
+        written = offset + length;
+    };
+    auto writeColumn = [&](uint64_t offset, const vector<int>& column) {
+        vector<int32_t> ordered(numProcesses);
+        for(unsigned int i = 0; i < numProcesses; i++) {
+            ordered[i] = column[order[i]];
+        }
+        writeSection(offset, ordered.data(), ordered.size() * sizeof(int32_t));
+    };
+
+    uint64_t columnBytes = alignSection(numProcesses * sizeof(int32_t));
+    writeSection(0, &header, sizeof(header));
+    writeColumn(layout.computationTimes, processes.totalTimeNeeded);
+    if(processType == INTERACTIVE) {
+        writeColumn(layout.typeColumns, processes.priority);
+    } else if(processType == REALTIME) {
+        writeColumn(layout.typeColumns, processes.period);
+        writeColumn(layout.typeColumns + columnBytes, processes.deadline);
+    }
+    if(!distinctIds) {
+        writeSection(layout.idIndices, idIndices.data(), idIndices.size() * sizeof(uint32_t));
+    }
+    writeSection(layout.idText, ids.text.data(), ids.text.size());
+    writeSection(layout.idLengths, idLengths.data(), idLengths.size());
+    writeSection(layout.arrivalTimes, arrivals.data(), arrivals.size());
+
+    out.close();
+    if(out.fail()) {
+        cerr << "Failed to write \"" << filename << "\"" << endl;
+        exit(-1);
+    }
+}
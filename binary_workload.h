@@ -0,0 +1,59 @@
+#ifndef BINARY_WORKLOAD_H
+#define BINARY_WORKLOAD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "process.h"
+#include "process_table.h"
+
+using namespace std;
+
+const char BINARY_WORKLOAD_MAGIC[4] = {'S', 'S', 'W', 'L'};  // the first bytes of every binary workload file
+const uint32_t BINARY_WORKLOAD_VERSION = 1;  // the version of the layout written by writeBinaryWorkload
+const uint32_t BINARY_WORKLOAD_DISTINCT_IDS = 1;  // header flag: process i has id i, so the id indices are left out
+
+/**
+ * Fixed header at the start of a binary workload file
+ * The header is followed by these sections:
+ * - the computation time of every process (int32)
+ * - the priority of every interactive process, or the period and then the deadline of every realtime process (int32)
+ * - the index of every process's id in the id table (uint32), unless the BINARY_WORKLOAD_DISTINCT_IDS flag is set
+ * - the text of every distinct id, one after another
+ * - the length of every distinct id, as varints
+ * - the arrival time of every process, as zigzag varint deltas from the previous process
+ * The fixed-width sections start on 8-byte boundaries so they can be copied straight into the process table
+ * Processes are stored in order of arrival, and every number is little-endian
+ */
+struct BinaryWorkloadHeader {
+    char magic[4];  // BINARY_WORKLOAD_MAGIC
+    uint32_t version;  // BINARY_WORKLOAD_VERSION
+    uint32_t processType;  // the ProcessType of every process
+    uint32_t flags;  // BINARY_WORKLOAD_DISTINCT_IDS or 0
+    uint64_t numProcesses;  // the number of processes
+    uint64_t numIds;  // the number of distinct process ids
+    uint64_t idTextLength;  // the number of bytes in the text of the ids
+    uint64_t idLengthsLength;  // the number of bytes in the encoded id lengths
+    uint64_t arrivalLength;  // the number of bytes in the encoded arrival times
+};
+
+/**
+ * Byte offsets of the sections of a binary workload file, computed from its header
+ */
+struct BinaryWorkloadLayout {
+    uint64_t computationTimes = 0;  // start of the computation times
+    uint64_t typeColumns = 0;  // start of the priorities, or of the periods followed by the deadlines
+    uint64_t idIndices = 0;  // start of the id indices
+    uint64_t idText = 0;  // start of the text of the ids
+    uint64_t idLengths = 0;  // start of the encoded id lengths
+    uint64_t arrivalTimes = 0;  // start of the encoded arrival times
+    uint64_t end = 0;  // the size of the file
+};
+
+BinaryWorkloadLayout binaryWorkloadLayout(const BinaryWorkloadHeader& header);
+bool isBinaryWorkload(const char* begin, const char* end);
+void readBinaryWorkload(const string& filename, const char* begin, const char* end, ProcessType processType, ProcessTable& processes);
+void writeBinaryWorkload(const string& filename, const ProcessTable& processes);
+
+#endif //BINARY_WORKLOAD_H
@@ -0,0 +1,174 @@
+#ifndef BURST_MODEL_H
+#define BURST_MODEL_H
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <vector>
+
+#include "process_behavior.h"
+#include "process_table.h"
+#include "scheduling_algorithms/ready_heap.h"
+
+using namespace std;
+
+/**
+ * CPU and I/O bursts of the processes in a simulation, driven by a ProcessBehavior coroutine per process
+ * Without a burst model a process computes from its arrival until it finishes; with one, it computes for the CPU
+ * burst its behavior yields, then leaves its CPU and is blocked until the device completes its I/O burst, when it
+ * becomes ready again and is handed back to the scheduler as if it had just arrived
+ * The blocked processes wait in a queue ordered by when their I/O completes, so the simulator finds the next
+ * device completion without scanning them, and can jump straight to it like it does to the next arrival
+ * A behavior is started when its process arrives and destroyed when the process finishes, so only the processes
+ * in the system hold a coroutine frame, and the CPU time a process needs is still its computation time: CPU
+ * bursts are cut short once it is used up, and a behavior that ends early finishes with one last CPU burst
+ */
+class BurstModel {
+
+public:
+
+    // creates the behavior of a process from its row in the table
+    using BehaviorFactory = function<ProcessBehavior(const ProcessTable& processes, int processIndex)>;
+
+    /**
+     * Constructor for the bursts of every process in a table
+     * @param processes The table of processes
+     * @param factory Creates the behavior of a process when it arrives
+     */
+    BurstModel(const ProcessTable& processes, BehaviorFactory factory)
+        : factory(move(factory)), behaviors(processes.size()), burstEnd(processes.size(), 0),
+          blockedSince(processes.size(), 0), timeBlocked(processes.size(), 0) {}
+
+    /**
+     * Starts the behavior of a process that has just arrived, running it up to its first CPU burst
+     * @param processIndex The index of the process
+     * @param time The time the process arrived
+     * @param processes The table of processes
+     * @return Whether the process is ready to run, rather than blocked on I/O straight away
+     */
+    bool processArrived(int processIndex, int time, ProcessTable& processes) {
+        behaviors[processIndex] = factory(processes, processIndex);
+        burstEnd[processIndex] = processes.timeScheduled[processIndex];
+        return !resume(processIndex, time, processes);
+    }
+
+    /**
+     * Moves a process on to its next burst if it has just run to the end of its CPU burst, and frees its
+     * behavior once it has finished
+     * @param processIndex The index of a process that has just run
+     * @param time The first time step after it ran
+     * @param processes The table of processes
+     * @return Whether the process left its CPU to wait for I/O
+     */
+    bool processRan(int processIndex, int time, ProcessTable& processes) {
+        if(processes.isDone(processIndex)) {
+            behaviors[processIndex].destroy();
+            return false;
+        }
+        if(processes.timeScheduled[processIndex] < burstEnd[processIndex]) {
+            return false;
+        }
+        return resume(processIndex, time, processes);
+    }
+
+    /**
+     * Takes the next process whose I/O has completed by a time, running its behavior up to its next CPU burst
+     * Processes whose next burst is more I/O go back into the blocked queue instead of being returned
+     * @param time The current time
+     * @param processes The table of processes
+     * @return The index of a process that is ready to run again, or -1 if no more have completed their I/O
+     */
+    int wake(int time, ProcessTable& processes) {
+        while(!blockedProcesses.empty() && blockedProcesses.top().key <= time) {
+            int processIndex = blockedProcesses.pop();
+            processes.markUnblocked(processIndex);
+            timeBlocked[processIndex] += time - blockedSince[processIndex];
+            if(!resume(processIndex, time, processes)) {
+                return processIndex;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * @param processIndex The index of a process that is ready to run
+     * @param processes The table of processes
+     * @return The time the process can run for before its CPU burst ends
+     */
+    int cpuTimeLeft(int processIndex, const ProcessTable& processes) const {
+        return burstEnd[processIndex] - processes.timeScheduled[processIndex];
+    }
+
+    /**
+     * @return The time the next I/O completes, or INT_MAX if no process is blocked
+     */
+    int nextCompletion() const {
+        return blockedProcesses.empty() ? INT_MAX : blockedProcesses.top().key;
+    }
+
+    /**
+     * @param processIndex The index of a process
+     * @return The number of time steps the process has spent blocked on I/O
+     */
+    int getTimeBlocked(int processIndex) const {
+        return timeBlocked[processIndex];
+    }
+
+    /**
+     * @return The number of I/O bursts that processes have started
+     */
+    long long getIoBursts() const {
+        return ioBursts;
+    }
+
+    /**
+     * @return The largest number of processes that were blocked on I/O at once
+     */
+    unsigned int getPeakBlocked() const {
+        return peakBlocked;
+    }
+
+private:
+
+    BehaviorFactory factory;  // creates the behavior of each process
+    vector<ProcessBehavior> behaviors;  // the suspended behavior of each process in the system
+    vector<int> burstEnd;  // the time scheduled each process will have when its current CPU burst ends
+    vector<int> blockedSince;  // the time each blocked process started its current I/O burst
+    vector<int> timeBlocked;  // the number of time steps each process has spent blocked on I/O
+    ReadyHeap blockedProcesses;  // the blocked processes, keyed on the time their I/O completes
+    long long ioBursts = 0;  // the number of I/O bursts started
+    unsigned int peakBlocked = 0;  // the largest number of processes blocked at once
+
+    /**
+     * Runs the behavior of a process whose CPU burst has ended up to its next burst, blocking the process if
+     * that burst is I/O
+     * @param processIndex The index of the process
+     * @param time The current time
+     * @param processes The table of processes
+     * @return Whether the process is blocked on I/O
+     */
+    bool resume(int processIndex, int time, ProcessTable& processes) {
+        int totalTimeNeeded = processes.totalTimeNeeded[processIndex];
+        Burst burst;
+        while(burstEnd[processIndex] < totalTimeNeeded) {
+            if(!behaviors[processIndex].next(burst)) {
+                burstEnd[processIndex] = totalTimeNeeded;  // the rest of the computation is one last CPU burst
+            } else if(burst.kind == CPU_BURST && burst.length > 0) {
+                burstEnd[processIndex] += min(burst.length, totalTimeNeeded - burstEnd[processIndex]);
+                return false;
+            } else if(burst.kind == IO_BURST) {
+                // the I/O takes at least one time step, so the scheduler sees the process leave before it returns
+                processes.markBlocked(processIndex);
+                blockedSince[processIndex] = time;
+                blockedProcesses.push(time + max(1, burst.length), processIndex);
+                ioBursts++;
+                peakBlocked = max(peakBlocked, blockedProcesses.size());
+                return true;
+            }
+        }
+        return false;
+    }
+
+};
+
+#endif //BURST_MODEL_H
@@ -0,0 +1,223 @@
+#ifndef EVENT_COUNTERS_H
+#define EVENT_COUNTERS_H
+
+#include <algorithm>
+#include <vector>
+
+#include "process_table.h"
+#include "scheduler.h"
+
+using namespace std;
+
+// The counters are only kept in builds made with -DSCHEDULER_COUNTERS (make counters); otherwise every
+// method returns straight away and the compiler removes the calls
+#ifdef SCHEDULER_COUNTERS
+const bool EVENT_COUNTERS_ENABLED = true;
+#else
+const bool EVENT_COUNTERS_ENABLED = false;
+#endif
+
+/**
+ * Data structure for the state of the ready queues at one sampled time step
+ */
+struct QueueDepthSample {
+    int time = 0;  // the time step
+    int busyCpus = 0;  // the number of CPUs running a process
+    vector<int> depths;  // the number of waiting processes in each queue, summed over every run queue
+};
+
+/**
+ * Operational counters of a simulation, reported to by the simulator on every decision point
+ * Counts context switches and preemptions, tracks how deep each of the schedulers' ready queues gets, and
+ * records the longest stretch of time each process spent waiting for a CPU (to expose starvation)
+ * A context switch is a CPU starting a different process from the one it ran before, including after being idle,
+ * and a preemption is a process losing its CPU before it has finished
+ * Queue depths can also be sampled every fixed number of time steps as a time series
+ */
+class EventCounters {
+
+public:
+
+    /**
+     * Sets up the counters for a simulation
+     * @param numProcesses The number of processes being simulated
+     * @param numCpus The number of CPUs being simulated
+     */
+    void start(int numProcesses, int numCpus) {
+        if(!EVENT_COUNTERS_ENABLED) {
+            return;
+        }
+        readySince.assign(numProcesses, 0);
+        longestWaits.assign(numProcesses, 0);
+        lastRunning.assign(numCpus, -1);
+    }
+
+    /**
+     * Starts sampling the queue depths
+     * @param interval The number of time steps between samples, or 0 to stop sampling
+     */
+    void setSampleInterval(int interval) {
+        sampleInterval = interval;
+        nextSample = 0;
+    }
+
+    /**
+     * Records that a process is ready to run from the time it arrives
+     * @param processIndex The index of the process that arrived
+     * @param time The time it arrived
+     */
+    void processArrived(int processIndex, int time) {
+        if(!EVENT_COUNTERS_ENABLED) {
+            return;
+        }
+        readySince[processIndex] = time;
+    }
+
+    /**
+     * Records the decisions the schedulers made for a slice of time steps, before the slice is run
+     * @param time The first time step of the slice
+     * @param duration The number of time steps in the slice
+     * @param running The process chosen for each CPU; done processes and -1 leave the CPU idle
+     * @param schedulers The schedulers whose ready queues are measured
+     * @param processes The table of processes
+     */
+    template<class SchedulerType>
+    void recordStep(int time, int duration, const vector<int>& running, const vector<SchedulerType*>& schedulers,
+                    const ProcessTable& processes) {
+        if(!EVENT_COUNTERS_ENABLED) {
+            return;
+        }
+
+        // processes that lost their CPU wait from now on, even if another CPU takes them at once, unless they
+        // finished or left it to wait for I/O
+        for(unsigned int cpu = 0; cpu < running.size(); cpu++) {
+            int previous = lastRunning[cpu];
+            if(previous >= 0 && previous != activeProcess(running[cpu], processes) && processes.isRunnable(previous)) {
+                preemptions++;
+                readySince[previous] = time;
+            }
+        }
+
+        int busyCpus = 0;
+        for(unsigned int cpu = 0; cpu < running.size(); cpu++) {
+            int next = activeProcess(running[cpu], processes);
+            if(next >= 0) {
+                busyCpus++;
+                if(next != lastRunning[cpu]) {
+                    contextSwitches++;
+                    longestWaits[next] = max(longestWaits[next], time - readySince[next]);
+                }
+            }
+            lastRunning[cpu] = next;
+        }
+
+        // the queues keep the same depths for the whole slice
+        depths.clear();
+        for(SchedulerType* scheduler : schedulers) {
+            scheduler->queueDepths(queueDepths);
+            if(depths.size() < queueDepths.size()) {
+                depths.resize(queueDepths.size(), 0);
+            }
+            for(unsigned int queue = 0; queue < queueDepths.size(); queue++) {
+                depths[queue] += queueDepths[queue];
+            }
+        }
+        if(depthTime.size() < depths.size()) {
+            depthTime.resize(depths.size(), 0);
+            maxDepths.resize(depths.size(), 0);
+        }
+        for(unsigned int queue = 0; queue < depths.size(); queue++) {
+            depthTime[queue] += static_cast<long long>(depths[queue]) * duration;
+            maxDepths[queue] = max(maxDepths[queue], depths[queue]);
+        }
+        totalTime += duration;
+
+        while(sampleInterval > 0 && nextSample < time + duration) {
+            nextSample = max(nextSample, time);
+            samples.push_back(QueueDepthSample{nextSample, busyCpus, depths});
+            nextSample += sampleInterval;
+        }
+    }
+
+    /**
+     * @return The number of times a CPU started running a different process
+     */
+    long long getContextSwitches() const {
+        return contextSwitches;
+    }
+
+    /**
+     * @return The number of times a process lost its CPU before finishing
+     */
+    long long getPreemptions() const {
+        return preemptions;
+    }
+
+    /**
+     * @return The number of ready queues the schedulers reported
+     */
+    int getNumQueues() const {
+        return maxDepths.size();
+    }
+
+    /**
+     * @param queue A ready queue, counting from 0
+     * @return The mean number of processes waiting in the queue over every time step
+     */
+    double getMeanQueueDepth(int queue) const {
+        return totalTime > 0 ? depthTime[queue] / static_cast<double>(totalTime) : 0;
+    }
+
+    /**
+     * @param queue A ready queue, counting from 0
+     * @return The largest number of processes that waited in the queue at once
+     */
+    int getMaxQueueDepth(int queue) const {
+        return maxDepths[queue];
+    }
+
+    /**
+     * @return The longest time each process spent ready but not running, in one stretch
+     */
+    const vector<int>& getLongestWaits() const {
+        return longestWaits;
+    }
+
+    /**
+     * @return The sampled queue depths, in order of time
+     */
+    const vector<QueueDepthSample>& getSamples() const {
+        return samples;
+    }
+
+private:
+
+    long long contextSwitches = 0;  // the number of times a CPU started running a different process
+    long long preemptions = 0;  // the number of times a process lost its CPU before finishing
+    vector<int> lastRunning;  // the process each CPU ran in the last slice, or -1 if it was idle
+    vector<int> readySince;  // the time each process last became ready to run
+    vector<int> longestWaits;  // the longest time each process spent ready but not running
+    vector<int> depths;  // the depth of each queue in the current slice, summed over the schedulers
+    vector<int> queueDepths;  // the depths reported by one scheduler
+    vector<long long> depthTime;  // the depth of each queue summed over every time step
+    vector<int> maxDepths;  // the largest depth of each queue
+    long long totalTime = 0;  // the number of time steps recorded
+    int sampleInterval = 0;  // the number of time steps between samples, or 0 for none
+    int nextSample = 0;  // the time step of the next sample
+    vector<QueueDepthSample> samples;  // the sampled queue depths
+
+    /**
+     * @param processIndex A process chosen by a scheduler
+     * @param processes The table of processes
+     * @return The process, or -1 if it leaves the CPU idle
+     */
+    static int activeProcess(int processIndex, const ProcessTable& processes) {
+        if(processIndex < 0 || static_cast<unsigned int>(processIndex) >= processes.size() || !processes.isRunnable(processIndex)) {
+            return -1;
+        }
+        return processIndex;
+    }
+
+};
+
+#endif //EVENT_COUNTERS_H
@@ -0,0 +1,90 @@
+#ifndef FLAG_PARSING_H
+#define FLAG_PARSING_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+/**
+ * Terminates the program because a flag was given a value that is not a number of the right kind
+ * @param flag The flag, such as --cpus
+ */
+[[noreturn]] inline void invalidFlagValue(const string& flag) {
+    cerr << "Invalid value for " << flag << endl;
+    exit(-1);
+}
+
+/**
+ * Reads the value of a flag with one of the standard string to number conversions, terminating the program if
+ * the value is not a number, does not fit in the type, or has anything after the number
+ * @param flag The flag, such as --cpus
+ * @param value The value given for the flag
+ * @param convert The conversion, called with the value and where to store the number of characters it used
+ * @return The number
+ */
+template<class Number, class Conversion>
+Number parseFlag(const string& flag, const string& value, Conversion convert) {
+    size_t length = 0;
+    Number number = 0;
+    try {
+        number = convert(value, &length);
+    } catch(const invalid_argument&) {
+        invalidFlagValue(flag);
+    } catch(const out_of_range&) {
+        invalidFlagValue(flag);
+    }
+    if(length != value.size()) {
+        invalidFlagValue(flag);
+    }
+    return number;
+}
+
+/**
+ * Reads the value of a flag as a whole number, terminating the program if it is not one or does not fit in an int
+ * @param flag The flag, such as --cpus
+ * @param value The value given for the flag
+ * @return The number
+ */
+inline int parseIntegerFlag(const string& flag, const string& value) {
+    return parseFlag<int>(flag, value, [](const string& text, size_t* length) { return stoi(text, length); });
+}
+
+/**
+ * Reads the value of a flag as a whole number that may not fit in an int, terminating the program if it is not one
+ * @param flag The flag, such as --count
+ * @param value The value given for the flag
+ * @return The number
+ */
+inline long long parseLongFlag(const string& flag, const string& value) {
+    return parseFlag<long long>(flag, value, [](const string& text, size_t* length) { return stoll(text, length); });
+}
+
+/**
+ * Reads the value of a flag as a non-negative 64-bit number, terminating the program if it is not one
+ * @param flag The flag, such as --seed
+ * @param value The value given for the flag
+ * @return The number
+ */
+inline uint64_t parseUnsignedFlag(const string& flag, const string& value) {
+    // stoull accepts a minus sign and wraps the number around, so negative values are rejected before it sees them
+    if(value.find('-') != string::npos) {
+        invalidFlagValue(flag);
+    }
+    return parseFlag<uint64_t>(flag, value, [](const string& text, size_t* length) { return stoull(text, length); });
+}
+
+/**
+ * Reads the value of a flag as a decimal number, terminating the program if it is not one
+ * @param flag The flag, such as --rate
+ * @param value The value given for the flag
+ * @return The number
+ */
+inline double parseDecimalFlag(const string& flag, const string& value) {
+    return parseFlag<double>(flag, value, [](const string& text, size_t* length) { return stod(text, length); });
+}
+
+#endif //FLAG_PARSING_H
@@ -0,0 +1,124 @@
+#include <iostream>
+
+#include "gantt.h"
+#include "main.h"
+
+using namespace std;
+
+/**
+ * Opens a Gantt chart file and writes its header, terminating the program if the file cannot be opened
+ * @param filename The file to write the chart to
+ * @param format The format of the chart
+ * @param processes The table of processes being simulated
+ * @param numCpus The number of CPUs being simulated
+ */
+GanttWriter::GanttWriter(const string& filename, GanttFormat format, const ProcessTable& processes, int numCpus)
+        : buffer(BUFFER_SIZE), format(format), processes(processes), open(numCpus) {
+
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());  // must be set before the file is opened
+    file.open(filename.c_str());
+    if(file.fail()) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    if(format == GANTT_CSV) {
+        file << "process,id,cpu,start,end\n";
+    } else {
+        file << "{\n  \"intervals\": [";
+    }
+}
+
+/**
+ * Adds a slice of the simulation to the chart, extending the interval of every CPU that kept its process
+ * and writing the intervals that ended
+ * @param slice The slice of time steps that was just simulated
+ */
+void GanttWriter::record(const TimeSlice& slice) {
+    for(unsigned int cpu = 0; cpu < slice.cpus.size(); cpu++) {
+        GanttInterval& interval = open[cpu];
+        int processIndex = slice.cpus[cpu].processIndex;
+
+        if(processIndex >= 0 && processIndex == interval.processIndex && slice.startTime == interval.end) {
+            interval.end += slice.duration;
+            continue;
+        }
+
+        if(interval.processIndex >= 0) {
+            write(interval);
+        }
+        interval.processIndex = processIndex;
+        interval.cpu = cpu;
+        interval.start = slice.startTime;
+        interval.end = slice.startTime + slice.duration;
+    }
+}
+
+/**
+ * Writes the intervals that are still open and finishes the file
+ */
+void GanttWriter::close() {
+    for(GanttInterval& interval : open) {
+        if(interval.processIndex >= 0) {
+            write(interval);
+            interval.processIndex = -1;
+        }
+    }
+
+    if(format == GANTT_JSON) {
+        file << (firstInterval ? "]\n}\n" : "\n  ]\n}\n");
+    }
+    file.close();
+}
+
+/**
+ * Writes one interval as a line of the chart
+ * Processes are numbered from 1, as in the process table
+ * @param interval The interval
+ */
+void GanttWriter::write(const GanttInterval& interval) {
+    if(format == GANTT_CSV) {
+        file << interval.processIndex + 1 << ','
+             << csvEscape(processes.getId(interval.processIndex)) << ','
+             << interval.cpu << ','
+             << interval.start << ','
+             << interval.end << '\n';
+    } else {
+        file << (firstInterval ? "\n    {" : ",\n    {")
+             << "\"process\": " << interval.processIndex + 1 << ", "
+             << "\"id\": \"" << jsonEscape(processes.getId(interval.processIndex)) << "\", "
+             << "\"cpu\": " << interval.cpu << ", "
+             << "\"start\": " << interval.start << ", "
+             << "\"end\": " << interval.end << "}";
+    }
+    firstInterval = false;
+}
+
+/**
+ * @param filename The name of a Gantt chart file
+ * @return GANTT_JSON if the name ends in .json, otherwise GANTT_CSV
+ */
+GanttFormat ganttFormatForFile(const string& filename) {
+    const string extension = ".json";
+    bool isJson = filename.size() >= extension.size()
+                  && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+    return isJson ? GANTT_JSON : GANTT_CSV;
+}
+
+/**
+ * @param text The text to put in a CSV field
+ * @return The text, quoted with its quotes doubled if it contains a comma, quote, or line break
+ */
+string csvEscape(string_view text) {
+    if(text.find_first_of(",\"\r\n") == string_view::npos) {
+        return string(text);
+    }
+    string escaped = "\"";
+    for(char c : text) {
+        escaped += c;
+        if(c == '"') {
+            escaped += '"';
+        }
+    }
+    return escaped + "\"";
+}
@@ -0,0 +1,64 @@
+#ifndef GANTT_H
+#define GANTT_H
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "process_table.h"
+#include "simulator.h"
+
+using namespace std;
+
+/**
+ * File formats for a Gantt chart
+ */
+enum GanttFormat {
+    GANTT_CSV,  // a header line, then one line per interval
+    GANTT_JSON  // an object with an array of intervals
+};
+
+/**
+ * Data structure for a stretch of time when one process ran on one CPU without interruption
+ */
+struct GanttInterval {
+    int processIndex = -1;  // the process that ran, or -1 if the interval is empty
+    int cpu = 0;  // the CPU it ran on
+    int start = 0;  // the first time step it ran
+    int end = 0;  // the time step after the last one it ran
+};
+
+/**
+ * Writes the Gantt chart of a simulation as it runs, as run-length intervals of each process on each CPU
+ * Consecutive time slices where a CPU keeps running the same process are merged into one interval, and an
+ * interval is written as soon as it ends, so only one interval per CPU is held in memory
+ * The file is written through a large buffer and never flushed until it is closed
+ */
+class GanttWriter {
+
+public:
+
+    GanttWriter(const string& filename, GanttFormat format, const ProcessTable& processes, int numCpus);
+    void record(const TimeSlice& slice);
+    void close();
+
+private:
+
+    static const size_t BUFFER_SIZE = 1 << 20;  // bytes of output held before writing to the file
+
+    ofstream file;  // the file the chart is written to
+    vector<char> buffer;  // the file's output buffer
+    GanttFormat format = GANTT_CSV;  // the format of the file
+    const ProcessTable& processes;  // the processes being simulated, for their ids
+    vector<GanttInterval> open;  // the interval each CPU is in the middle of
+    bool firstInterval = true;  // whether no interval has been written yet
+
+    void write(const GanttInterval& interval);
+
+};
+
+GanttFormat ganttFormatForFile(const string& filename);
+string csvEscape(string_view text);
+
+#endif //GANTT_H
@@ -0,0 +1,127 @@
+#ifndef LOG_HISTOGRAM_H
+#define LOG_HISTOGRAM_H
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Histogram of non-negative values in log-scaled buckets, after the HDR histogram
+ * Every power of two is split into 2^SUB_BUCKET_BITS equal buckets, so values below 2^(SUB_BUCKET_BITS + 1) are
+ * counted exactly and larger ones are only rounded to within 1 part in 2^SUB_BUCKET_BITS
+ * Recording a value takes O(1) time, and the number of buckets only grows with the logarithm of the largest
+ * value, so memory stays constant no matter how many values are recorded
+ * The count, sum, minimum, and maximum are kept exactly
+ */
+class LogHistogram {
+
+public:
+
+    static const int SUB_BUCKET_BITS = 10;  // quantiles are within 1/1024 (0.1%) of the recorded values
+
+    /**
+     * Counts a value
+     * @param value The value, where negative values count as 0
+     */
+    void record(long long value) {
+        value = max(value, 0LL);
+        unsigned int index = bucketIndex(value);
+        if(index >= counts.size()) {
+            counts.resize(index + 1, 0);
+        }
+        counts[index]++;
+        total++;
+        sum += value;
+        minimum = min(minimum, value);
+        maximum = max(maximum, value);
+    }
+
+    /**
+     * @return The number of values counted
+     */
+    long long count() const {
+        return total;
+    }
+
+    /**
+     * @return The mean of the values, or 0 if there are none
+     */
+    double mean() const {
+        return total > 0 ? static_cast<double>(sum / total) : 0;
+    }
+
+    /**
+     * @return The smallest value, or 0 if there are none
+     */
+    long long smallest() const {
+        return total > 0 ? minimum : 0;
+    }
+
+    /**
+     * @return The largest value, or 0 if there are none
+     */
+    long long largest() const {
+        return total > 0 ? maximum : 0;
+    }
+
+    /**
+     * @param fraction The fraction of values that should be at or below the result, from 0 to 1
+     * @return The smallest value that at least that fraction of the values are at or below, rounded up to the
+     *         end of its bucket (but never past the largest value), or 0 if there are no values
+     */
+    long long quantile(double fraction) const {
+        if(total == 0) {
+            return 0;
+        }
+        long long rank = static_cast<long long>(fraction * total);
+        if(rank < fraction * total || rank == 0) {
+            rank++;  // round up to the next whole value
+        }
+        long long seen = 0;
+        for(unsigned int index = 0; index < counts.size(); index++) {
+            seen += counts[index];
+            if(seen >= rank) {
+                return min(bucketEnd(index), maximum);
+            }
+        }
+        return maximum;
+    }
+
+private:
+
+    vector<long long> counts;  // the number of values in each bucket
+    long long total = 0;  // the number of values counted
+    long double sum = 0;  // the sum of the values counted
+    long long minimum = LLONG_MAX;  // the smallest value counted
+    long long maximum = 0;  // the largest value counted
+
+    /**
+     * @param value A non-negative value
+     * @return The index of the bucket the value falls in
+     */
+    static unsigned int bucketIndex(unsigned long long value) {
+        if(value < (1ULL << (SUB_BUCKET_BITS + 1))) {
+            return value;
+        }
+        int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+        return ((shift + 1) << SUB_BUCKET_BITS) + (value >> shift) - (1ULL << SUB_BUCKET_BITS);
+    }
+
+    /**
+     * @param index The index of a bucket
+     * @return The largest value that falls in the bucket
+     */
+    static long long bucketEnd(unsigned int index) {
+        if(index < (1u << (SUB_BUCKET_BITS + 1))) {
+            return index;
+        }
+        int shift = (index >> SUB_BUCKET_BITS) - 1;
+        long long start = static_cast<long long>((1u << SUB_BUCKET_BITS) + (index & ((1u << SUB_BUCKET_BITS) - 1))) << shift;
+        return start + (1LL << shift) - 1;
+    }
+
+};
+
+#endif //LOG_HISTOGRAM_H
@@ -6,11 +6,16 @@
 #include <fstream>
 
 #include "main.h"
+#include "flag_parsing.h"
+#include "burst_model.h"
+#include "gantt.h"
+#include "memory_statistics.h"
+#include "replicate.h"
+#include "sweep.h"
 #include "scheduler.h"
+#include "simulator.h"
 #include "process.h"
-#include "realtime_process.h"
-#include "interactive_process.h"
-#include "batch_process.h"
+#include "process_table.h"
 
 #include "scheduling_algorithms/first_in_first_out.h"
 #include "scheduling_algorithms/shortest_process_next.h"
@@ -21,6 +26,8 @@
 #include "scheduling_algorithms/multilevel_feedback.h"
 #include "scheduling_algorithms/rate_monotonic.h"
 #include "scheduling_algorithms/earliest_deadline_first.h"
+#include "scheduling_algorithms/schedulability_analysis.h"
+#include "scheduler_dispatch.h"
 
 using namespace std;
 
@@ -35,12 +42,29 @@ using namespace std;
 int main(int argc, char* argv[]) {
 
     string filename;
-    int currentTime = 0;
     chrono::duration<int, std::milli> sleepTime = chrono::milliseconds(500);
-    vector<Process*> processList;
-    int processIndex;
-    bool allProcessesComplete;
-    int timesIdle = 0;  // counter for the number of time steps when the CPU was idle
+    ProcessTable processes;
+
+    // --sweep compares every compatible scheduler on a set of workload files
+    for(int i = 1; i < argc; i++) {
+        if(string(argv[i]) == "--sweep") {
+            return runSweep(argc, argv);
+        }
+    }
+
+    // --replicate simulates one scheduler on many randomized copies of a workload
+    for(int i = 1; i < argc; i++) {
+        if(string(argv[i]) == "--replicate") {
+            return runReplications(argc, argv);
+        }
+    }
+
+    // Other flags select the headless mode, where every choice comes from the command line
+    for(int i = 1; i < argc; i++) {
+        if(string(argv[i]).rfind("--", 0) == 0) {
+            return runHeadless(argc, argv);
+        }
+    }
 
     // Take in command-line arguments
     // Format: process_file sleep_time
@@ -52,7 +76,12 @@ int main(int argc, char* argv[]) {
         exit(-1);
     } else {
         filename = argv[1];
-        sleepTime = chrono::milliseconds(stoul(argv[2]));
+        int milliseconds = parseIntegerFlag("the sleep time", argv[2]);
+        if(milliseconds < 0) {
+            cerr << "The sleep time cannot be negative" << endl;
+            exit(-1);
+        }
+        sleepTime = chrono::milliseconds(milliseconds);
     }
 
     cout << "----------------------------------------------" << endl;
@@ -63,11 +92,781 @@ int main(int argc, char* argv[]) {
     ProcessType processType = promptForProcessType();
 
     // Read processes from file into a vector
-    readProcessFile(filename, processType, processList);
+    readProcessFile(filename, processType, processes);
 
-    Scheduler* schedulingAlgorithm;
     // Prompt the user to select the scheduling algorithm for the selected process type
     int schedulerType = promptForSchedulingAlgorithm(processType);
+    Scheduler* schedulingAlgorithm = createScheduler(processType, schedulerType, processes, quantum);
+
+    cout << endl << "Starting simulation..." << endl << endl;
+    cout << "+--------------------------------------------------------------------------+" << endl;
+    cout << "|                                   KEY                                    |" << endl;
+    cout << "+--------------------------------------------------------------------------+" << endl;
+    cout << "| The leftmost column indicates the current time                           |" << endl;
+    cout << "| The middle columns correspond to one of the processes                    |" << endl;
+    cout << "|     0: The process is running                                            |" << endl;
+    cout << "|     blank: The process is not running                                    |" << endl;
+    cout << "|     X: The process is running and finished at this time                  |" << endl;
+    cout << "|     !: The process has run for longer than its required computation time |" << endl;
+    cout << "| The rightmost column indicates whether the CPU is idle                   |" << endl;
+    cout << "|     +: CPU is running a process                                          |" << endl;
+    cout << "|     -: CPU is idle                                                       |" << endl;
+    cout << "+--------------------------------------------------------------------------+" << endl;
+    cout << endl << endl;
+
+    outputTableHeader(cout, processes.size());
+
+    Simulator simulator(schedulingAlgorithm, processes);
+    simulator.setKeepOverruns(true);  // the table marks a finished process that the scheduler keeps running with !
+
+    while(!simulator.isComplete()) {
+
+        // Simulate up to the next point where the scheduler's choice can change
+        const TimeSlice& slice = simulator.step();
+
+        // Output a row for every clock cycle in the slice
+        for(int time = slice.startTime; time < slice.startTime + slice.duration; time++) {
+            outputTimeStep(cout, slice, time, processes.size());
+
+            if(!simulator.isComplete() || time < simulator.getCurrentTime()) {
+                cout.flush();  // rows are not flushed as they are written, so show this one before waiting
+                this_thread::sleep_for(sleepTime);  // delay between each clock cycle
+            }
+        }
+
+    }
+
+    // Once finished, output statistics about the run
+    outputStatistics(processes, processType, simulator.getTimesIdle(), simulator.getCurrentTime(), simulator.getMetrics());
+
+    delete schedulingAlgorithm;
+
+    return 0;
+}
+
+/**
+ * Runs a simulation without any prompts or delays
+ * The process type, scheduling algorithm, and its parameters are taken from command-line flags, the process
+ * table is only written if a file is given for it, and the run statistics are printed as JSON
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return 0 if the run is successful
+ */
+int runHeadless(int argc, char* argv[]) {
+
+    HeadlessOptions options = parseHeadlessOptions(argc, argv);
+    ProcessTable processes;
+
+    readProcessFile(options.filename, options.processType, processes);
+
+    if(options.analyze) {
+        return runSchedulabilityAnalysis(options, processes);
+    }
+
+    // Periodic tasks are simulated as the jobs they release
+    ProcessTable tasks;
+    vector<int> jobTasks;
+    if(options.periodic) {
+        tasks = move(processes);
+        if(options.horizon == 0) {
+            options.horizon = defaultPeriodicHorizon(tasks);
+        }
+        releasePeriodicJobs(tasks, options.horizon, processes, jobTasks);
+    }
+
+    if(options.forkTime >= 0) {
+        return runForkedBranches(options, processes);
+    }
+
+    vector<Scheduler*> schedulingAlgorithms = createSchedulers(options.processType, options.schedulerType, processes,
+                                                               options.timeQuantum, options.numCpus, options.queueMode);
+
+    // The process table is only produced when a file was given for it
+    ofstream tableFile;
+    if(!options.tableFilename.empty()) {
+        tableFile.open(options.tableFilename.c_str());
+        if(tableFile.fail()) {
+            cerr << "Unable to open file \"" << options.tableFilename << "\", terminating program" << endl;
+            exit(-1);
+        }
+        outputTableHeader(tableFile, processes.size(), options.numCpus);
+    }
+
+    // The Gantt chart is written as the simulation runs, one interval at a time
+    unique_ptr<GanttWriter> gantt;
+    if(!options.ganttFilename.empty()) {
+        gantt = make_unique<GanttWriter>(options.ganttFilename, ganttFormatForFile(options.ganttFilename), processes,
+                                         options.numCpus);
+    }
+
+    // Memory used from here on is counted for the simulation, separately from loading the processes
+    MemoryStatistics loadMemory = currentMemoryStatistics();
+    resetPeakMemory();
+
+    // The simulation loop is compiled for the concrete scheduler type, unless the virtual methods were asked for
+    auto simulate = [&](const auto& schedulers) {
+        BasicSimulator simulator(schedulers, processes, options.numCpus, options.queueMode);
+        if(!options.queueSamplesFilename.empty()) {
+            simulator.sampleQueueDepths(options.sampleInterval);
+        }
+
+        // Each process runs as a coroutine that alternates CPU bursts with I/O requests
+        unique_ptr<BurstModel> bursts;
+        if(options.cpuBurstLength > 0) {
+            bursts = make_unique<BurstModel>(processes, [&options](const ProcessTable& processes, int processIndex) {
+                return alternatingBursts(processes.totalTimeNeeded[processIndex], options.cpuBurstLength,
+                                         options.ioBurstLength);
+            });
+            simulator.setBurstModel(bursts.get());
+        }
+
+        while(!simulator.isComplete()) {
+            const TimeSlice& slice = simulator.step();
+
+            if(gantt) {
+                gantt->record(slice);
+            }
+            if(tableFile.is_open()) {
+                for(int time = slice.startTime; time < slice.startTime + slice.duration; time++) {
+                    outputTimeStep(tableFile, slice, time, processes.size());
+                }
+            }
+        }
+        MemoryStatistics simulationMemory = memoryUsedSince(loadMemory);
+
+        if(gantt) {
+            gantt->close();
+        }
+
+        if(!options.queueSamplesFilename.empty()) {
+            ofstream samplesFile(options.queueSamplesFilename.c_str());
+            if(samplesFile.fail()) {
+                cerr << "Unable to open file \"" << options.queueSamplesFilename << "\", terminating program" << endl;
+                exit(-1);
+            }
+            outputQueueSamples(samplesFile, simulator.getEvents());
+        }
+
+        vector<PeriodicTaskStatistics> taskStatistics;
+        if(options.periodic) {
+            taskStatistics = computeTaskStatistics(tasks, processes, jobTasks);
+        }
+        outputStatisticsJson(cout, processes, options, simulator, loadMemory, simulationMemory, taskStatistics);
+    };
+    if(options.virtualDispatch) {
+        simulate(schedulingAlgorithms);
+    } else {
+        visitSchedulers(options.processType, options.schedulerType, schedulingAlgorithms, simulate);
+    }
+
+    for(Scheduler* schedulingAlgorithm : schedulingAlgorithms) {
+        delete schedulingAlgorithm;
+    }
+
+    return 0;
+}
+
+/**
+ * Simulates the processes with the chosen scheduler up to a point in time, then continues the simulation from
+ * that point once with every scheduler for the process type, and prints the statistics of each continuation
+ * as JSON
+ * The chosen scheduler carries on from its own state, so its branch gives the same results as a run without a
+ * fork, while every other scheduler takes over the waiting and running processes as they were at that point
+ * The simulation up to the fork is only run once, and every branch restores its state into the same table
+ * @param options The options for the run
+ * @param processes The table of processes
+ * @return 0 if the run is successful
+ */
+int runForkedBranches(const HeadlessOptions& options, ProcessTable& processes) {
+
+    // Simulate up to the fork, stopping exactly at its time
+    SimulationSnapshot snapshot;
+    vector<Scheduler*> schedulingAlgorithms = createSchedulers(options.processType, options.schedulerType, processes,
+                                                               options.timeQuantum, options.numCpus, options.queueMode);
+    auto simulatePrefix = [&](const auto& schedulers) {
+        BasicSimulator simulator(schedulers, processes, options.numCpus, options.queueMode);
+        while(!simulator.isComplete() && simulator.getCurrentTime() < options.forkTime) {
+            simulator.step(options.forkTime);
+        }
+        snapshot = simulator.snapshot();
+    };
+    if(options.virtualDispatch) {
+        simulatePrefix(schedulingAlgorithms);
+    } else {
+        visitSchedulers(options.processType, options.schedulerType, schedulingAlgorithms, simulatePrefix);
+    }
+    for(Scheduler* schedulingAlgorithm : schedulingAlgorithms) {
+        delete schedulingAlgorithm;
+    }
+
+    // Continue from the fork with every scheduler in turn
+    const vector<string>& names = schedulerNames(options.processType);
+    vector<RunStatistics> branches;
+    for(unsigned int i = 0; i < names.size(); i++) {
+        int schedulerType = i + 1;
+        bool continued = schedulerType == options.schedulerType;
+        vector<Scheduler*> branchSchedulers = continued ? snapshot.copySchedulers()
+            : createSchedulers(options.processType, schedulerType, processes, options.timeQuantum, options.numCpus,
+                               options.queueMode);
+
+        auto simulateBranch = [&](const auto& schedulers) {
+            BasicSimulator simulator(snapshot, schedulers, processes);
+            if(!continued) {
+                simulator.handOverProcesses();
+            }
+            while(!simulator.isComplete()) {
+                simulator.step();
+            }
+            branches.push_back(computeStatistics(processes, options.processType, simulator));
+        };
+        if(options.virtualDispatch) {
+            simulateBranch(branchSchedulers);
+        } else {
+            visitSchedulers(options.processType, schedulerType, branchSchedulers, simulateBranch);
+        }
+        for(Scheduler* schedulingAlgorithm : branchSchedulers) {
+            delete schedulingAlgorithm;
+        }
+    }
+
+    cout << setprecision(6) << fixed;
+    cout << "{" << endl;
+    cout << "  \"file\": \"" << jsonEscape(options.filename) << "\"," << endl;
+    cout << "  \"processType\": \"" << processTypeName(options.processType) << "\"," << endl;
+    cout << "  \"scheduler\": \"" << names.at(options.schedulerType - 1) << "\"," << endl;
+    cout << "  \"timeQuantum\": " << options.timeQuantum << "," << endl;
+    cout << "  \"numCpus\": " << options.numCpus << "," << endl;
+    cout << "  \"queues\": \"" << queueModeName(options.queueMode) << "\"," << endl;
+    cout << "  \"numProcesses\": " << processes.size() << "," << endl;
+    cout << "  \"forkTime\": " << snapshot.getTime() << "," << endl;
+    cout << "  \"completeAtFork\": " << (snapshot.isComplete() ? "true" : "false") << "," << endl;
+    cout << "  \"branches\": [";
+    for(unsigned int i = 0; i < branches.size(); i++) {
+        const RunStatistics& statistics = branches[i];
+        cout << (i == 0 ? "" : ",") << "\n    {"
+             << "\"scheduler\": \"" << names[i] << "\", "
+             << "\"continued\": " << (static_cast<int>(i) + 1 == options.schedulerType ? "true" : "false") << ", "
+             << "\"finishTime\": " << statistics.finishTime << ", "
+             << "\"idleCycles\": " << statistics.timesIdle << ", "
+             << "\"meanTurnaroundTime\": " << statistics.meanTurnaroundTime << ", "
+             << "\"meanNormalizedTurnaroundTime\": " << statistics.meanNormalizedTurnaroundTime << ", "
+             << "\"migrations\": " << statistics.migrations;
+        if(options.processType == REALTIME) {
+            cout << ", \"metDeadlinesPercentage\": " << statistics.metDeadlinesPercentage;
+        }
+        cout << "}";
+    }
+    cout << "\n  ]" << endl;
+    cout << "}" << endl;
+
+    return 0;
+}
+
+/**
+ * Tests whether periodic realtime tasks are schedulable with RM or EDF on one CPU without simulating them, and
+ * prints the verdict as JSON
+ * RM gets the Liu and Layland and hyperbolic bounds and response-time analysis, and EDF the processor-demand test
+ * With a cross-check, the tasks are also simulated from the critical instant (every task starting at time 0) until
+ * the horizon, with each job due at the end of the last time step the analysis allows it, and the simulated
+ * deadline misses and response times are reported next to the analytical ones
+ * Over one hyperperiod the simulation is exact unless the tasks need more than the whole CPU, in which case it
+ * can only confirm a miss
+ * @param options The options for the run
+ * @param tasks The table of realtime tasks
+ * @return 0 if the run is successful
+ */
+int runSchedulabilityAnalysis(const HeadlessOptions& options, const ProcessTable& tasks) {
+
+    bool isRateMonotonic = schedulerNames(REALTIME).at(options.schedulerType - 1) == "rm";
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    SchedulabilityAnalysis analysis(tasks);
+    vector<long long> responseTimes;
+    bool schedulable = isRateMonotonic ? analysis.rateMonotonicResponseTimes(responseTimes)
+                                       : analysis.earliestDeadlineFirstDemand();
+    bool passesLiuLayland = isRateMonotonic && analysis.passesLiuLayland();
+    bool passesHyperbolicBound = isRateMonotonic && analysis.passesHyperbolicBound();
+    chrono::duration<double, micro> analysisTime = chrono::steady_clock::now() - start;
+
+    // The cross-check simulates the synchronous release of the tasks, shifting each deadline back by one time
+    // step since the simulator counts a job finishing during the time step of its deadline as on time
+    ProcessTable jobs;
+    vector<int> jobTasks;
+    vector<PeriodicTaskStatistics> taskStatistics;
+    int horizon = options.horizon;
+    if(options.crossCheck) {
+        ProcessTable synchronousTasks = tasks;
+        for(unsigned int i = 0; i < synchronousTasks.size(); i++) {
+            synchronousTasks.deadline[i] -= synchronousTasks.arrivalTime[i] + 1;
+            synchronousTasks.arrivalTime[i] = 0;
+        }
+        if(horizon == 0) {
+            horizon = defaultPeriodicHorizon(synchronousTasks);
+        }
+        releasePeriodicJobs(synchronousTasks, horizon, jobs, jobTasks);
+
+        Scheduler* schedulingAlgorithm = createScheduler(REALTIME, options.schedulerType, jobs, options.timeQuantum);
+        visitSchedulers(REALTIME, options.schedulerType, {schedulingAlgorithm}, [&](const auto& schedulers) {
+            BasicSimulator simulator(schedulers, jobs, 1, GLOBAL_QUEUE);
+            while(!simulator.isComplete()) {
+                simulator.step();
+            }
+        });
+        delete schedulingAlgorithm;
+
+        taskStatistics = computeTaskStatistics(synchronousTasks, jobs, jobTasks);
+    }
+
+    cout << setprecision(6) << fixed;
+    cout << "{" << endl;
+    cout << "  \"file\": \"" << jsonEscape(options.filename) << "\"," << endl;
+    cout << "  \"processType\": \"" << processTypeName(options.processType) << "\"," << endl;
+    cout << "  \"scheduler\": \"" << schedulerNames(options.processType).at(options.schedulerType - 1) << "\"," << endl;
+    cout << "  \"numTasks\": " << analysis.size() << "," << endl;
+    cout << "  \"utilization\": " << analysis.utilization() << "," << endl;
+    if(isRateMonotonic) {
+        cout << "  \"liuLaylandBound\": " << analysis.liuLaylandBound() << "," << endl;
+        cout << "  \"passesLiuLayland\": " << (passesLiuLayland ? "true" : "false") << "," << endl;
+        cout << "  \"passesHyperbolicBound\": " << (passesHyperbolicBound ? "true" : "false") << "," << endl;
+    }
+    cout << "  \"exactTest\": \"" << (isRateMonotonic ? "response-time analysis" : "processor demand") << "\"," << endl;
+    cout << "  \"schedulable\": " << (schedulable ? "true" : "false") << "," << endl;
+    cout << "  \"analysisMicroseconds\": " << analysisTime.count() << "," << endl;
+
+    int simulatedMisses = 0;
+    cout << "  \"tasks\": [";
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        cout << (i == 0 ? "" : ",") << "\n    {"
+             << "\"id\": \"" << jsonEscape(tasks.getId(i)) << "\", "
+             << "\"computationTime\": " << tasks.totalTimeNeeded[i] << ", "
+             << "\"period\": " << tasks.period[i] << ", "
+             << "\"relativeDeadline\": " << tasks.deadline[i] - tasks.arrivalTime[i];
+        if(isRateMonotonic) {
+            cout << ", \"worstResponseTime\": ";
+            if(responseTimes[i] < 0) {
+                cout << "null";
+            } else {
+                cout << responseTimes[i];
+            }
+        }
+        if(options.crossCheck) {
+            // jobs finish at the end of a time step, so a job's response time is one more than its turnaround time
+            cout << ", \"simulatedWorstResponseTime\": " << taskStatistics[i].worstTurnaroundTime + 1
+                 << ", \"simulatedMissedDeadlines\": " << taskStatistics[i].missedDeadlines;
+            simulatedMisses += taskStatistics[i].missedDeadlines;
+        }
+        cout << "}";
+    }
+    cout << (tasks.empty() ? "]" : "\n  ]");
+
+    if(options.crossCheck) {
+        cout << "," << endl;
+        cout << "  \"crossCheck\": {"
+             << "\"horizon\": " << horizon << ", "
+             << "\"jobs\": " << jobs.size() << ", "
+             << "\"missedDeadlines\": " << simulatedMisses << ", "
+             << "\"schedulable\": " << (simulatedMisses == 0 ? "true" : "false") << ", "
+             << "\"agrees\": ";
+        if(simulatedMisses == 0 && analysis.utilization() > 1) {
+            // an overloaded CPU falls behind without bound, but its first miss can come after the horizon
+            cout << "null}";
+        } else {
+            cout << ((simulatedMisses == 0) == schedulable ? "true" : "false") << "}";
+        }
+    }
+    cout << endl << "}" << endl;
+
+    return 0;
+}
+
+/**
+ * Print how to run the program in headless mode
+ * @param out The stream to write the usage to
+ */
+void outputHeadlessUsage(ostream& out) {
+    out << "Usage: program --type TYPE --scheduler SCHEDULER [options] process_file" << endl;
+    out << "  --type TYPE            batch, interactive, or realtime" << endl;
+    out << "  --scheduler SCHEDULER  batch: fifo, spn, srt, hrrn" << endl;
+    out << "                         interactive: rr, ml, mlf, fifo" << endl;
+    out << "                         realtime: rm, edf, fifo" << endl;
+    out << "  --quantum N            time quantum for rr and ml, and for the top level of mlf (default " << quantum << ")" << endl;
+    out << "  --table FILE           write the per-clock-cycle process table to FILE (meant for small runs)" << endl;
+    out << "  --gantt FILE           write when each process ran on each CPU to FILE, as CSV, or as JSON if FILE" << endl;
+    out << "                         ends in .json" << endl;
+    out << "  --cpus N               number of CPUs to simulate (default 1)" << endl;
+    out << "  --queues MODE          global: the CPUs share one run queue (default)" << endl;
+    out << "                         per-cpu: each CPU has its own run queue, and idle CPUs steal work" << endl;
+    out << "  --periodic             treat realtime processes as periodic tasks that release a job every period" << endl;
+    out << "  --horizon N            with --periodic, release jobs until time N (default: one hyperperiod)" << endl;
+    out << "  --analyze              test whether periodic realtime tasks are schedulable with rm or edf on one CPU" << endl;
+    out << "                         analytically, instead of simulating them" << endl;
+    out << "  --cross-check          with --analyze, also simulate the tasks from the critical instant and compare" << endl;
+    out << "  --dispatch MODE        static: compile the simulation loop for the scheduler's type (default)" << endl;
+    out << "                         virtual: call the scheduler through its virtual methods" << endl;
+    out << "  --queue-samples FILE   write the depth of every ready queue to FILE as CSV, every --sample-interval" << endl;
+    out << "                         time steps (needs a build with event counters: make counters)" << endl;
+    out << "  --sample-interval N    time steps between queue depth samples (default 1)" << endl;
+    out << "  --fork-at T            simulate up to time T, then continue from there with every scheduler for the" << endl;
+    out << "                         process type, and print the statistics of each continuation" << endl;
+    out << "  --io-bursts C,I        every process computes for C time steps at a time, then leaves its CPU for an" << endl;
+    out << "                         I/O request that takes I time steps, until its computation time is used up" << endl;
+}
+
+/**
+ * Read the flags for a headless run, terminating the program if any are missing or invalid
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return The options for the run
+ */
+HeadlessOptions parseHeadlessOptions(int argc, char* argv[]) {
+
+    HeadlessOptions options;
+    options.timeQuantum = quantum;
+    string schedulerName;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--help") {
+            outputHeadlessUsage(cout);
+            exit(0);
+        } else if(argument.rfind("--", 0) != 0) {
+            if(!options.filename.empty()) {
+                cerr << "Unexpected argument \"" << argument << "\"" << endl;
+                outputHeadlessUsage(cerr);
+                exit(-1);
+            }
+            options.filename = argument;
+            continue;
+        } else if(argument == "--periodic") {
+            options.periodic = true;
+            continue;
+        } else if(argument == "--analyze") {
+            options.analyze = true;
+            continue;
+        } else if(argument == "--cross-check") {
+            options.analyze = true;
+            options.crossCheck = true;
+            continue;
+        }
+
+        // every remaining flag takes a value
+        if(i + 1 >= argc) {
+            cerr << "Missing value for " << argument << endl;
+            outputHeadlessUsage(cerr);
+            exit(-1);
+        }
+        string value = argv[++i];
+
+        if(argument == "--type") {
+            options.processType = processTypeFromName(value);
+            if(options.processType == NONE) {
+                cerr << "Invalid process type \"" << value << "\"" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--scheduler") {
+            schedulerName = value;
+        } else if(argument == "--quantum") {
+            options.timeQuantum = parseIntegerFlag(argument, value);
+            if(options.timeQuantum < 1) {
+                cerr << "The time quantum must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--table") {
+            options.tableFilename = value;
+        } else if(argument == "--gantt") {
+            options.ganttFilename = value;
+        } else if(argument == "--cpus") {
+            options.numCpus = parseIntegerFlag(argument, value);
+            if(options.numCpus < 1) {
+                cerr << "The number of CPUs must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--queues") {
+            if(!queueModeFromName(value, options.queueMode)) {
+                cerr << "Invalid queue mode \"" << value << "\"" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--dispatch") {
+            if(value != "static" && value != "virtual") {
+                cerr << "Invalid dispatch mode \"" << value << "\"" << endl;
+                exit(-1);
+            }
+            options.virtualDispatch = value == "virtual";
+        } else if(argument == "--queue-samples") {
+            options.queueSamplesFilename = value;
+        } else if(argument == "--sample-interval") {
+            options.sampleInterval = parseIntegerFlag(argument, value);
+            if(options.sampleInterval < 1) {
+                cerr << "The sample interval must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--fork-at") {
+            options.forkTime = parseIntegerFlag(argument, value);
+            if(options.forkTime < 0) {
+                cerr << "The fork time cannot be negative" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--io-bursts") {
+            size_t comma = value.find(',');
+            if(comma == string::npos) {
+                cerr << "The I/O bursts must be given as CPU,IO" << endl;
+                exit(-1);
+            }
+            options.cpuBurstLength = parseIntegerFlag(argument, value.substr(0, comma));
+            options.ioBurstLength = parseIntegerFlag(argument, value.substr(comma + 1));
+            if(options.cpuBurstLength < 1 || options.ioBurstLength < 1) {
+                cerr << "CPU and I/O bursts must last at least 1 time step" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--horizon") {
+            options.horizon = parseIntegerFlag(argument, value);
+            options.periodic = true;
+            if(options.horizon < 1) {
+                cerr << "The horizon must be at least 1" << endl;
+                exit(-1);
+            }
+        } else {
+            cerr << "Unknown flag " << argument << endl;
+            outputHeadlessUsage(cerr);
+            exit(-1);
+        }
+    }
+
+    if(options.filename.empty()) {
+        cerr << "Did not specify process file" << endl;
+        exit(-1);
+    } else if(options.processType == NONE) {
+        cerr << "Did not specify process type" << endl;
+        exit(-1);
+    } else if(schedulerName.empty()) {
+        cerr << "Did not specify scheduler" << endl;
+        exit(-1);
+    } else if((options.periodic || options.analyze) && options.processType != REALTIME) {
+        cerr << "Only realtime processes can be periodic" << endl;
+        exit(-1);
+    } else if(options.analyze && options.numCpus != 1) {
+        cerr << "Schedulability analysis is only available for one CPU" << endl;
+        exit(-1);
+    } else if(!options.queueSamplesFilename.empty() && !EVENT_COUNTERS_ENABLED) {
+        cerr << "Queue depth samples need a build with event counters (make counters)" << endl;
+        exit(-1);
+    } else if(options.forkTime >= 0 && (options.analyze || !options.tableFilename.empty() ||
+                                        !options.ganttFilename.empty() || !options.queueSamplesFilename.empty())) {
+        cerr << "--fork-at cannot be combined with --analyze, --table, --gantt, or --queue-samples" << endl;
+        exit(-1);
+    } else if(options.cpuBurstLength > 0 && (options.analyze || options.forkTime >= 0)) {
+        cerr << "--io-bursts cannot be combined with --analyze or --fork-at" << endl;
+        exit(-1);
+    }
+
+    options.schedulerType = schedulerTypeFromName(options.processType, schedulerName);
+    if(options.schedulerType < 0) {
+        cerr << "Scheduler \"" << schedulerName << "\" is not available for " << processTypeName(options.processType)
+             << " processes" << endl;
+        exit(-1);
+    } else if(options.analyze && schedulerName != "rm" && schedulerName != "edf") {
+        cerr << "Schedulability analysis is only available for rm and edf" << endl;
+        exit(-1);
+    }
+
+    return options;
+}
+
+/**
+ * @param name The name of a process type (batch, interactive, or realtime)
+ * @return The corresponding ProcessType, or NONE if the name is not recognized
+ */
+ProcessType processTypeFromName(const string& name) {
+    for(int type = BATCH; type <= REALTIME; type++) {
+        if(name == processTypeName(static_cast<ProcessType>(type))) {
+            return static_cast<ProcessType>(type);
+        }
+    }
+    return NONE;
+}
+
+/**
+ * @param processType A process type
+ * @return The lowercase name of the process type
+ */
+string processTypeName(ProcessType processType) {
+    switch(processType) {
+        case BATCH:
+            return "batch";
+        case INTERACTIVE:
+            return "interactive";
+        case REALTIME:
+            return "realtime";
+        default:
+            return "none";
+    }
+}
+
+/**
+ * Find the number of a scheduling algorithm from its abbreviation
+ * The numbers match the options listed by promptForSchedulingAlgorithm
+ * @param processType The type of processes being simulated
+ * @param name The lowercase abbreviation of the algorithm (e.g. "rr" or "edf")
+ * @return The number of the algorithm, or -1 if it is not available for the process type
+ */
+int schedulerTypeFromName(ProcessType processType, const string& name) {
+    const vector<string>& names = schedulerNames(processType);
+    for(unsigned int i = 0; i < names.size(); i++) {
+        if(name == names[i]) {
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @param processType A process type
+ * @return The abbreviations of the scheduling algorithms available for the process type, in menu order
+ */
+const vector<string>& schedulerNames(ProcessType processType) {
+    static const vector<string> batchNames = {"fifo", "spn", "srt", "hrrn"};
+    static const vector<string> interactiveNames = {"rr", "ml", "mlf", "fifo"};
+    static const vector<string> realtimeNames = {"rm", "edf", "fifo"};
+    static const vector<string> noNames;
+
+    switch(processType) {
+        case BATCH:
+            return batchNames;
+        case INTERACTIVE:
+            return interactiveNames;
+        case REALTIME:
+            return realtimeNames;
+        default:
+            return noNames;
+    }
+}
+
+/**
+ * @param name The name of a queue mode (global or per-cpu)
+ * @param queueMode Set to the corresponding QueueMode if the name is recognized
+ * @return Whether the name is recognized
+ */
+bool queueModeFromName(const string& name, QueueMode& queueMode) {
+    for(QueueMode mode : {GLOBAL_QUEUE, PER_CPU_QUEUES}) {
+        if(name == queueModeName(mode)) {
+            queueMode = mode;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @param queueMode A queue mode
+ * @return The name of the queue mode
+ */
+string queueModeName(QueueMode queueMode) {
+    return queueMode == PER_CPU_QUEUES ? "per-cpu" : "global";
+}
+
+/**
+ * Output the header of the process table, with one column per process and one per CPU
+ * @param out The stream to write the header to
+ * @param numProcesses The number of processes in the simulation
+ * @param numCpus The number of CPUs in the simulation
+ */
+void outputTableHeader(ostream& out, unsigned int numProcesses, int numCpus) {
+
+    int width = processColumnWidth(numProcesses);
+
+    out << "Time |";
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        out << "  " << left << setw(width - 2) << "P" + to_string(i + 1) << right << "|";
+    }
+    if(numCpus == 1) {
+        out << "  CPU |";
+    } else {
+        for(int cpu = 0; cpu < numCpus; cpu++) {
+            out << setw(5) << "CPU" + to_string(cpu) << " |";
+        }
+    }
+    out << '\n';
+
+    out << "-----";
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        out << "+" << string(width, '-');
+    }
+    for(int cpu = 0; cpu < numCpus; cpu++) {
+        out << "+------";
+    }
+    out << "+" << '\n';
+}
+
+/**
+ * @param numProcesses The number of processes in the table
+ * @return The width of each process's column in the process table, enough for the label of the last process
+ */
+int processColumnWidth(unsigned int numProcesses) {
+    return max(6, static_cast<int>(to_string(numProcesses).size()) + 4);
+}
+
+/**
+ * Output the row of the process table for a single clock cycle
+ * @param out The stream to write the row to
+ * @param slice The slice of the simulation that the clock cycle belongs to
+ * @param time The time of the clock cycle
+ * @param numProcesses The number of processes in the simulation
+ */
+void outputTimeStep(ostream& out, const TimeSlice& slice, int time, unsigned int numProcesses) {
+
+    bool isLastStep = time == slice.startTime + slice.duration - 1;
+    string padding(processColumnWidth(numProcesses) - 5, ' ');  // the rest of each process's column
+
+    out << setw(4) << time;
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        // find the CPU the process is running on, if any
+        const CpuSlice* cpuSlice = nullptr;
+        for(const CpuSlice& cpu : slice.cpus) {
+            if(cpu.processIndex == static_cast<int>(i)) {
+                cpuSlice = &cpu;
+            }
+        }
+
+        if(cpuSlice == nullptr) {
+            out << " |    " << padding;
+        } else if(cpuSlice->overran) {
+            out << " |   !" << padding;  // the process has run for longer than its required computation time
+        } else if(cpuSlice->finished && isLastStep) {
+            out << " |   X" << padding;
+        } else {
+            out << " |   O" << padding;
+        }
+    }
+
+    // Last columns indicate CPU status
+    if(slice.cpus.size() == 1) {
+        if(slice.cpus[0].processIndex < 0) {
+            out << " |   - ";  // CPU is idle; no currently running process
+        } else {
+            out << " |   + ";  // CPU has a running process
+        }
+    } else {
+        // with several CPUs, each column names the process its CPU is running
+        for(unsigned int cpu = 0; cpu < slice.cpus.size(); cpu++) {
+            int processIndex = slice.cpus[cpu].processIndex;
+            out << " |" << setw(4) << (processIndex < 0 ? "-" : "P" + to_string(processIndex + 1)) << " ";
+        }
+    }
+    out << " |" << '\n';
+}
+
+/**
+ * Create the scheduler for a process type and one of the scheduling algorithms listed for it
+ * @param processType The type of processes being simulated (BATCH, INTERACTIVE, or REALTIME)
+ * @param schedulerType The number of the algorithm, as listed by promptForSchedulingAlgorithm
+ * @param processes The table of processes to schedule
+ * @param timeQuantum The time quantum for the Round Robin based algorithms (RR, ML, and MLF)
+ * @return The scheduler, or nullptr if the combination is not valid
+ */
+Scheduler* createScheduler(ProcessType processType, int schedulerType, ProcessTable& processes, int timeQuantum) {
+
+    Scheduler* schedulingAlgorithm = nullptr;
 
     switch (processType) {
         case BATCH:
@@ -75,25 +874,25 @@ int main(int argc, char* argv[]) {
                 case 1:  // FIFO
                 {
                     FirstInFirstOut* fifo = new FirstInFirstOut;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(fifo);
+                    schedulingAlgorithm = fifo;
                     break;
                 }
                 case 2:  // SPN
                 {
                     ShortestProcessNext* spn = new ShortestProcessNext;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(spn);
+                    schedulingAlgorithm = spn;
                     break;
                 }
                 case 3:  // SRT
                 {
                     ShortestRemainingTime* srt = new ShortestRemainingTime;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(srt);
+                    schedulingAlgorithm = srt;
                     break;
                 }
                 case 4:  // HRRN
                 {
                     HighestResponseRatioNext* hrrn = new HighestResponseRatioNext;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(hrrn);
+                    schedulingAlgorithm = hrrn;
                     break;
                 }
             }
@@ -102,26 +901,26 @@ int main(int argc, char* argv[]) {
             switch(schedulerType) {
                 case 1:  // RR
                 {
-                    RoundRobin* rr = new RoundRobin;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(rr);
+                    RoundRobin* rr = new RoundRobin(timeQuantum, timeQuantum);
+                    schedulingAlgorithm = rr;
                     break;
                 }
                 case 2:  // ML
                 {
-                    Multilevel* ml = new Multilevel(processList);
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(ml);
+                    Multilevel* ml = new Multilevel(timeQuantum);
+                    schedulingAlgorithm = ml;
                     break;
                 }
                 case 3:  // MLF
                 {
-                    MultilevelFeedback* mlf = new MultilevelFeedback(processList);
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(mlf);
+                    MultilevelFeedback* mlf = new MultilevelFeedback(timeQuantum);
+                    schedulingAlgorithm = mlf;
                     break;
                 }
                 case 4:  // FIFO
                 {
                     FirstInFirstOut* fifo = new FirstInFirstOut;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(fifo);
+                    schedulingAlgorithm = fifo;
                     break;
                 }
             }
@@ -131,19 +930,19 @@ int main(int argc, char* argv[]) {
                 case 1:  // RM
                 {
                     RateMonotonic* rm = new RateMonotonic;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(rm);
+                    schedulingAlgorithm = rm;
                     break;
                 }
                 case 2:  // EDF
                 {
                     EarliestDeadlineFirst* edf = new EarliestDeadlineFirst;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(edf);
+                    schedulingAlgorithm = edf;
                     break;
                 }
                 case 3:  // FIFO
                 {
                     FirstInFirstOut* fifo = new FirstInFirstOut;
-                    schedulingAlgorithm = reinterpret_cast<Scheduler*>(fifo);
+                    schedulingAlgorithm = fifo;
                     break;
                 }
             }
@@ -152,178 +951,28 @@ int main(int argc, char* argv[]) {
             cerr << "Invalid process type" << endl;
     }
 
-    cout << endl << "Starting simulation..." << endl << endl;
-    cout << "+--------------------------------------------------------------------------+" << endl;
-    cout << "|                                   KEY                                    |" << endl;
-    cout << "+--------------------------------------------------------------------------+" << endl;
-    cout << "| The leftmost column indicates the current time                           |" << endl;
-    cout << "| The middle columns correspond to one of the processes                    |" << endl;
-    cout << "|     0: The process is running                                            |" << endl;
-    cout << "|     blank: The process is not running                                    |" << endl;
-    cout << "|     X: The process is running and finished at this time                  |" << endl;
-    cout << "|     !: The process has run for longer than its required computation time |" << endl;
-    cout << "| The rightmost column indicates whether the CPU is idle                   |" << endl;
-    cout << "|     +: CPU is running a process                                          |" << endl;
-    cout << "|     -: CPU is idle                                                       |" << endl;
-    cout << "+--------------------------------------------------------------------------+" << endl;
-    cout << endl << endl;
-
-    cout << "Time |";
-    for(int i = 0; i < processList.size(); i++) {
-        if(i + 1 < 10) {
-            cout << "  P" << i + 1 << "  |";
-        } else {
-            cout << "  P" << i + 1 << " |";
-        }
-    }
-    cout << "  CPU |" << endl;
-
-    cout << "-----";
-    for(int i = 0; i < processList.size(); i++) {
-        cout << "+------";
-    }
-    cout << "+------+" << endl;
-
-    allProcessesComplete = false;  // set flag for when CPU can quit
-    currentTime = 0;  // start out with a CPU time of 0
-    processIndex = -1;  // start with no process running on the CPU
-
-    while(!allProcessesComplete) {
-
-        // Update whether process has arrived at the CPU based on the current time
-        for(unsigned int i = 0; i < processList.size(); i++) {
-            if(currentTime == processList.at(i)->arrivalTime) {
-                processList.at(i)->hasArrived = true;
-            }
-        }
-
-        // Run the selected scheduling algorithm at the current time
-        processIndex = schedulingAlgorithm->run(processIndex, currentTime, processList);
-
-        // If the returned index is valid, then update its member variables accordingly
-        if(processIndex >= 0 && static_cast<unsigned int>(processIndex) < processList.size()) {
-            processList[processIndex]->timeScheduled++;  // The process was scheduled for another time unit
-            // Mark a process as done when its required computation time equals its time spent running on the CPU
-            if(processList[processIndex]->totalTimeNeeded == processList[processIndex]->timeScheduled) {
-                processList[processIndex]->isDone = true;
-                processList[processIndex]->timeFinished = currentTime;
-            }
-        }
-
-        // Output the row for the current clock cycle
-        cout << setw(4) << currentTime;
-        allProcessesComplete = true;
-        for(unsigned int i = 0; i < processList.size(); i++) {
-
-            // update whether all processes have completed
-            allProcessesComplete = allProcessesComplete && processList[i]->isDone;
-
-            if(i == processIndex) {
-                if(processList[i]->isDone) {
-                    if(processList[i]->timeScheduled > processList[i]->totalTimeNeeded) {
-                        cout << " |   ! ";
-                    }
-                    else {
-                        cout << " |   X ";
-                    }
-                } else {
-                    cout << " |   O ";
-                }
-            } else {
-                cout << " |     ";
-            }
-        }
-
-        // Last column indicates CPU status
-        if(processIndex < 0 || processIndex >= processList.size()) {
-            cout << " |   - ";  // CPU is idle; no currently running process
-            timesIdle++;
-        } else {
-            cout << " |   + ";  // CPU has a running process
-        }
-        cout << " |" << endl;
-
-        if(!allProcessesComplete) {
-            this_thread::sleep_for(sleepTime);  // delay between each clock cycle
-            currentTime = currentTime + 1;  // update the current time
-        }
-
-    }
-
-    // Once finished, output statistics about the run
-    outputStatistics(processList, processType, timesIdle, currentTime);
-
-    for(int i = 0; i < processList.size(); i++) {
-        delete processList.at(i);
-    }
-
-    return 0;
+    return schedulingAlgorithm;
 }
 
 /**
- * Read in data from a file and interpret it as a list of processes of a certain type
- * The first line of the file indicates the number of processes
- * Each following line represents a process with information such as the process id, arrival time,
- * required processing time, and additional data specific to the process type
- * @param fname The name of the file to read from
- * @param processType The type of processes in the given file
- * @param procList The list representation of all the processes
- * @post procList is filled with the processes from the file
+ * Create the schedulers for a simulation on one or more CPUs
+ * @param processType The type of processes being simulated (BATCH, INTERACTIVE, or REALTIME)
+ * @param schedulerType The number of the algorithm, as listed by promptForSchedulingAlgorithm
+ * @param processes The table of processes to schedule
+ * @param timeQuantum The time quantum for the Round Robin based algorithms (RR, ML, and MLF)
+ * @param numCpus The number of CPUs
+ * @param queueMode Whether the CPUs share one scheduler or each have their own
+ * @return One scheduler shared by every CPU, or one scheduler per CPU
  */
-void readProcessFile(const string& fname, const ProcessType processType, vector<Process*>& procList) {
+vector<Scheduler*> createSchedulers(ProcessType processType, int schedulerType, ProcessTable& processes, int timeQuantum,
+                                    int numCpus, QueueMode queueMode) {
 
-    ifstream in(fname.c_str());
-    int numProcesses;
-
-    if(in.fail()) {
-        cerr << "Unable to open file \"" << fname << "\", terminating program" << endl;
-        exit(-1);
+    vector<Scheduler*> schedulingAlgorithms(queueMode == PER_CPU_QUEUES ? numCpus : 1);
+    for(unsigned int i = 0; i < schedulingAlgorithms.size(); i++) {
+        schedulingAlgorithms[i] = createScheduler(processType, schedulerType, processes, timeQuantum);
     }
 
-    in >> numProcesses;
-    procList.resize(numProcesses);
-    for(int i = 0; i < procList.capacity(); i++) {
-        procList.at(i) = nullptr;
-    }
-
-    for(int i = 0; i < procList.capacity(); i++) {
-        switch (processType) {
-            case BATCH: {
-                BatchProcess* batchProcess = new BatchProcess;
-                in >> batchProcess->id
-                   >> batchProcess->arrivalTime
-                   >> batchProcess->totalTimeNeeded;
-                procList.at(i) = batchProcess;
-                break;
-            }
-            case INTERACTIVE: {
-                InteractiveProcess* interactiveProcess = new InteractiveProcess;
-                in >> interactiveProcess->id
-                   >> interactiveProcess->arrivalTime
-                   >> interactiveProcess->totalTimeNeeded
-                   >> interactiveProcess->priority;
-                procList.at(i) = interactiveProcess;
-                break;
-            }
-            case REALTIME: {
-                RealtimeProcess* realtimeProcess = new RealtimeProcess;
-                in >> realtimeProcess->id
-                   >> realtimeProcess->arrivalTime
-                   >> realtimeProcess->totalTimeNeeded
-                   >> realtimeProcess->period
-                   >> realtimeProcess->deadline;
-                procList.at(i) = realtimeProcess;
-                break;
-            }
-            default: {
-                cerr << "Invalid process type supplied: " << processType << endl;
-                exit(-1);
-            }
-        }
-
-    }
-
-    in.close();
+    return schedulingAlgorithms;
 }
 
 /**
@@ -425,12 +1074,14 @@ int promptForSchedulingAlgorithm(ProcessType processType) {
 /**
  * Print statistics about the simulation, including turnaround times, normalized turnaround times, amount of time
  * the processor was busy, and, for realtime processes, information about meeting deadlines
- * @param processList The list of processes
+ * @param processes The table of processes
  * @param selectedProcessType The process type the user selected to simulate
  * @param timesIdle The number of clock cycles the CPU was idle during the simulation
  * @param currentTime The time at the end of the simulation
+ * @param metrics The metrics recorded during the simulation
  */
-void outputStatistics(vector<Process*>& processList, ProcessType selectedProcessType, int timesIdle, int currentTime) {
+void outputStatistics(ProcessTable& processes, ProcessType selectedProcessType, int timesIdle, int currentTime,
+                      const RunMetrics& metrics) {
 
     cout << "\n\nRun Statistics:" << endl;
 
@@ -443,27 +1094,27 @@ void outputStatistics(vector<Process*>& processList, ProcessType selectedProcess
     cout << "----------------------------------------------------------------------" << endl;
 
     // Output process id, finish time, turnaround time, and normalized turnaround time for each process
-    for(int i = 0; i < processList.size(); i++) {
+    for(int i = 0; i < processes.size(); i++) {
 
         // compute turnaround time and normalized turnaround time for the process
-        int turnaroundTime = processList.at(i)->timeFinished - processList.at(i)->arrivalTime;
-        double normalizedTurnaroundTime = turnaroundTime / static_cast<double>(processList.at(i)->timeScheduled);
+        int turnaroundTime = processes.timeFinished[i] - processes.arrivalTime[i];
+        double normalizedTurnaroundTime = turnaroundTime / static_cast<double>(processes.timeScheduled[i]);
 
         // update sums
         turnaroundTimeSum += turnaroundTime;
         normalizedTurnaroundTimeSum += normalizedTurnaroundTime;
 
         // output process statistics as a row in the table
-        cout << setw(7) << processList.at(i)->id << " |";
-        cout << setw(12) << processList.at(i)->timeFinished << " |";
+        cout << setw(7) << processes.getId(i) << " |";
+        cout << setw(12) << processes.timeFinished[i] << " |";
         cout << setw(16) << turnaroundTime << " |";
         cout << setw(27) << fixed << setprecision(2) << normalizedTurnaroundTime << " |";
         cout << endl;
     }
 
     // compute the mean turnaround time and mean normalized turnaround time for all processes
-    double meanTurnaroundTime = turnaroundTimeSum / processList.size();
-    double meanNormalizedTurnaroundTime = normalizedTurnaroundTimeSum / processList.size();
+    double meanTurnaroundTime = turnaroundTimeSum / processes.size();
+    double meanNormalizedTurnaroundTime = normalizedTurnaroundTimeSum / processes.size();
 
     // output means as the final row in the table
     cout << "----------------------------------------------------------------------" << endl;
@@ -473,34 +1124,377 @@ void outputStatistics(vector<Process*>& processList, ProcessType selectedProcess
     cout << setw(27) << fixed << setprecision(2) << meanNormalizedTurnaroundTime << " |";
     cout << endl << endl;
 
+    // Output the distribution of each metric, recorded as the processes ran
+    const LatencyMetrics& latency = metrics.forType(selectedProcessType);
+    cout << setw(26) << "Percentile" << " |      p50 |      p99 |    p99.9 |      max |" << endl;
+    cout << "-----------------------------------------------------------------------" << endl;
+    outputPercentileRow("Turnaround Time", latency.turnaroundTime);
+    outputPercentileRow("Normalized Turnaround Time", latency.normalizedTurnaroundTime, NORMALIZED_TURNAROUND_SCALE);
+    outputPercentileRow("Waiting Time", latency.waitingTime);
+    outputPercentileRow("Response Time", latency.responseTime);
+    cout << endl;
+
     double idlePercentage = (timesIdle / (double)currentTime) * 100;
     cout << "The processor was idle for " << timesIdle << "/" << currentTime << " clock cycles (" << idlePercentage << "%)" << endl << endl;
 
     // For realtime processes, output how many met their deadlines
     if(selectedProcessType == REALTIME) {
         int metDeadlines = 0;
-        for(int i = 0; i < processList.size(); i++) {
-            RealtimeProcess* realtimeProcess = reinterpret_cast<RealtimeProcess*>(processList.at(i));
-
-            if(realtimeProcess->timeFinished <= realtimeProcess->deadline) {
+        for(int i = 0; i < processes.size(); i++) {
+            if(processes.timeFinished[i] <= processes.deadline[i]) {
                 metDeadlines++;
             }
         }
 
-        double metDeadlinesPercentage = (metDeadlines / (double)processList.size()) * 100;
+        double metDeadlinesPercentage = (metDeadlines / (double)processes.size()) * 100;
         cout << metDeadlinesPercentage << "% of processes met their deadlines." << endl;
 
-        for(int i = 0; i < processList.size(); i++) {
-            RealtimeProcess* realtimeProcess = reinterpret_cast<RealtimeProcess*>(processList.at(i));
+        for(int i = 0; i < processes.size(); i++) {
             cout << "    "
-                 << (realtimeProcess->timeFinished <= realtimeProcess->deadline ? "+" : "-")
+                 << (processes.timeFinished[i] <= processes.deadline[i] ? "+" : "-")
                  << " P"
                  << i + 1
                  << " had a deadline of "
-                 << realtimeProcess->deadline
+                 << processes.deadline[i]
                  << " and finished at "
-                 << realtimeProcess->timeFinished
+                 << processes.timeFinished[i]
                  << endl;
         }
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Print one metric's percentiles as a row of the table in outputStatistics
+ * @param name The name of the metric
+ * @param histogram The distribution of the metric
+ * @param scale The number of recorded units in one unit of the metric
+ */
+void outputPercentileRow(const string& name, const LogHistogram& histogram, int scale) {
+    cout << setw(26) << name << " |";
+    for(double fraction : {0.5, 0.99, 0.999}) {
+        cout << setw(9) << fixed << setprecision(2) << histogram.quantile(fraction) / static_cast<double>(scale) << " |";
+    }
+    cout << setw(9) << fixed << setprecision(2) << histogram.largest() / static_cast<double>(scale) << " |";
+    cout << endl;
+}
+
+/**
+ * Compute the summary statistics of a finished simulation
+ * @param processes The table of processes
+ * @param selectedProcessType The process type that was simulated
+ * @param simulator The finished simulation
+ * @return The summary statistics
+ */
+RunStatistics computeStatistics(ProcessTable& processes, ProcessType selectedProcessType, const SimulatorBase& simulator) {
+
+    int currentTime = simulator.getCurrentTime();
+    int timesIdle = simulator.getTimesIdle();
+
+    RunStatistics statistics;
+    statistics.numProcesses = processes.size();
+    statistics.finishTime = currentTime;
+    statistics.timesIdle = timesIdle;
+    statistics.numCpus = simulator.getNumCpus();
+    statistics.idlePercentage = currentTime > 0 ? (timesIdle / ((double)currentTime * statistics.numCpus)) * 100 : 0;
+    statistics.migrations = simulator.getMigrations();
+
+    // the clock runs from time 0 through currentTime
+    for(int cpu = 0; cpu < statistics.numCpus; cpu++) {
+        statistics.cpuUtilization.push_back((simulator.getBusyTime(cpu) / (double)(currentTime + 1)) * 100);
+    }
+
+    double turnaroundTimeSum = 0;
+    double normalizedTurnaroundTimeSum = 0;
+    for(unsigned int i = 0; i < processes.size(); i++) {
+        int turnaroundTime = processes.timeFinished[i] - processes.arrivalTime[i];
+        turnaroundTimeSum += turnaroundTime;
+        normalizedTurnaroundTimeSum += turnaroundTime / static_cast<double>(processes.timeScheduled[i]);
+
+        if(selectedProcessType == REALTIME) {
+            if(processes.timeFinished[i] <= processes.deadline[i]) {
+                statistics.metDeadlines++;
+            }
+        }
+    }
+
+    if(!processes.empty()) {
+        statistics.meanTurnaroundTime = turnaroundTimeSum / processes.size();
+        statistics.meanNormalizedTurnaroundTime = normalizedTurnaroundTimeSum / processes.size();
+        statistics.metDeadlinesPercentage = (statistics.metDeadlines / (double)processes.size()) * 100;
+    }
+
+    return statistics;
+}
+
+/**
+ * Print the statistics of a headless run as a single JSON object, including a row for every process
+ * @param out The stream to write the statistics to
+ * @param processes The table of processes
+ * @param options The options the run was made with
+ * @param simulator The finished simulation
+ * @param loadMemory The memory used to load the processes and create the schedulers
+ * @param simulationMemory The memory used by the simulation itself
+ * @param taskStatistics The statistics of each periodic task, if the processes are the jobs of periodic tasks
+ */
+void outputStatisticsJson(ostream& out, ProcessTable& processes, const HeadlessOptions& options, const SimulatorBase& simulator,
+                          const MemoryStatistics& loadMemory, const MemoryStatistics& simulationMemory,
+                          const vector<PeriodicTaskStatistics>& taskStatistics) {
+
+    RunStatistics statistics = computeStatistics(processes, options.processType, simulator);
+    bool isRealtime = options.processType == REALTIME;
+
+    out << setprecision(6) << fixed;
+    out << "{" << endl;
+    out << "  \"file\": \"" << jsonEscape(options.filename) << "\"," << endl;
+    out << "  \"processType\": \"" << processTypeName(options.processType) << "\"," << endl;
+    out << "  \"scheduler\": \"" << schedulerNames(options.processType).at(options.schedulerType - 1) << "\"," << endl;
+    out << "  \"timeQuantum\": " << options.timeQuantum << "," << endl;
+    out << "  \"numCpus\": " << statistics.numCpus << "," << endl;
+    out << "  \"queues\": \"" << queueModeName(options.queueMode) << "\"," << endl;
+    out << "  \"numProcesses\": " << statistics.numProcesses << "," << endl;
+    out << "  \"finishTime\": " << statistics.finishTime << "," << endl;
+    out << "  \"idleCycles\": " << statistics.timesIdle << "," << endl;
+    out << "  \"idlePercentage\": " << statistics.idlePercentage << "," << endl;
+    out << "  \"meanTurnaroundTime\": " << statistics.meanTurnaroundTime << "," << endl;
+    out << "  \"meanNormalizedTurnaroundTime\": " << statistics.meanNormalizedTurnaroundTime << "," << endl;
+    out << "  \"migrations\": " << statistics.migrations << "," << endl;
+    out << "  \"cpuUtilization\": [";
+    for(int cpu = 0; cpu < statistics.numCpus; cpu++) {
+        out << (cpu == 0 ? "" : ", ") << statistics.cpuUtilization[cpu];
+    }
+    out << "]," << endl;
+    if(isRealtime) {
+        out << "  \"metDeadlines\": " << statistics.metDeadlines << "," << endl;
+        out << "  \"metDeadlinesPercentage\": " << statistics.metDeadlinesPercentage << "," << endl;
+    }
+    if(options.periodic) {
+        out << "  \"horizon\": " << options.horizon << "," << endl;
+        out << "  \"tasks\": [";
+        for(unsigned int t = 0; t < taskStatistics.size(); t++) {
+            const PeriodicTaskStatistics& task = taskStatistics[t];
+            out << (t == 0 ? "" : ",") << "\n    {"
+                << "\"id\": \"" << jsonEscape(task.id) << "\", "
+                << "\"jobs\": " << task.numJobs << ", "
+                << "\"missedDeadlines\": " << task.missedDeadlines << ", "
+                << "\"worstTurnaroundTime\": " << task.worstTurnaroundTime << ", "
+                << "\"meanTurnaroundTime\": " << task.meanTurnaroundTime << "}";
+        }
+        out << (taskStatistics.empty() ? "]," : "\n  ],") << endl;
+    }
+
+    const BurstModel* bursts = simulator.getBurstModel();
+    if(bursts) {
+        outputBurstsJson(out, options, *bursts, processes.size());
+    }
+
+    const RunMetrics& metrics = simulator.getMetrics();
+    out << "  \"latency\": {" << endl;
+    outputLatencyJson(out, metrics.forType(options.processType), "    ");
+    if(options.processType == INTERACTIVE) {
+        out << "," << endl << "    \"byPriority\": [";
+        bool first = true;
+        for(int priority = 1; priority <= METRICS_PRIORITY_LEVELS; priority++) {
+            const LatencyMetrics& latency = metrics.forPriority(priority);
+            if(latency.turnaroundTime.count() == 0) {
+                continue;
+            }
+            out << (first ? "" : ",") << endl << "      {\"priority\": " << priority << "," << endl;
+            outputLatencyJson(out, latency, "        ");
+            out << "}";
+            first = false;
+        }
+        out << (first ? "]" : "\n    ]");
+    }
+    out << endl << "  }," << endl;
+
+    if(EVENT_COUNTERS_ENABLED) {
+        outputEventsJson(out, processes, simulator.getEvents());
+    }
+
+    out << "  \"memory\": {" << endl;
+    out << "    \"load\": ";
+    outputMemoryJson(out, loadMemory);
+    out << "," << endl << "    \"simulation\": ";
+    outputMemoryJson(out, simulationMemory);
+    out << endl << "  }," << endl;
+
+    out << "  \"processes\": [";
+    for(unsigned int i = 0; i < processes.size(); i++) {
+        int turnaroundTime = processes.timeFinished[i] - processes.arrivalTime[i];
+        double normalizedTurnaroundTime = turnaroundTime / static_cast<double>(processes.timeScheduled[i]);
+
+        out << (i == 0 ? "" : ",") << "\n    {"
+            << "\"id\": \"" << jsonEscape(processes.getId(i)) << "\", ";
+        if(options.periodic) {
+            out << "\"releaseTime\": " << processes.arrivalTime[i] << ", ";
+        }
+        out << "\"finishTime\": " << processes.timeFinished[i] << ", "
+            << "\"turnaroundTime\": " << turnaroundTime << ", "
+            << "\"normalizedTurnaroundTime\": " << normalizedTurnaroundTime;
+        if(isRealtime) {
+            out << ", \"deadline\": " << processes.deadline[i]
+                << ", \"metDeadline\": " << (processes.timeFinished[i] <= processes.deadline[i] ? "true" : "false");
+        }
+        if(bursts) {
+            out << ", \"timeBlocked\": " << bursts->getTimeBlocked(i);
+        }
+        if(EVENT_COUNTERS_ENABLED) {
+            out << ", \"longestWait\": " << simulator.getEvents().getLongestWaits()[i];
+        }
+        out << "}";
+    }
+    out << (processes.empty() ? "]" : "\n  ]") << endl;
+    out << "}" << endl;
+}
+
+/**
+ * Print the CPU and I/O bursts of a simulation as the "io" member of the JSON statistics
+ * @param out The stream to write the bursts to
+ * @param options The options the run was made with
+ * @param bursts The burst model of the finished simulation
+ * @param numProcesses The number of processes
+ */
+void outputBurstsJson(ostream& out, const HeadlessOptions& options, const BurstModel& bursts, unsigned int numProcesses) {
+
+    long long totalTimeBlocked = 0;
+    for(unsigned int i = 0; i < numProcesses; i++) {
+        totalTimeBlocked += bursts.getTimeBlocked(i);
+    }
+
+    out << "  \"io\": {" << endl;
+    out << "    \"cpuBurst\": " << options.cpuBurstLength << "," << endl;
+    out << "    \"ioBurst\": " << options.ioBurstLength << "," << endl;
+    out << "    \"ioBursts\": " << bursts.getIoBursts() << "," << endl;
+    out << "    \"peakBlocked\": " << bursts.getPeakBlocked() << "," << endl;
+    out << "    \"meanTimeBlocked\": " << (numProcesses > 0 ? totalTimeBlocked / static_cast<double>(numProcesses) : 0) << endl;
+    out << "  }," << endl;
+}
+
+/**
+ * Print the event counters of a simulation as the "events" member of the JSON statistics
+ * The longest waits are summarized over every process, and the process that waited longest is named
+ * @param out The stream to write the counters to
+ * @param processes The table of processes
+ * @param events The counters of the finished simulation
+ */
+void outputEventsJson(ostream& out, ProcessTable& processes, const EventCounters& events) {
+
+    LogHistogram longestWaits;
+    int mostStarved = -1;
+    const vector<int>& waits = events.getLongestWaits();
+    for(unsigned int i = 0; i < waits.size(); i++) {
+        longestWaits.record(waits[i]);
+        if(mostStarved < 0 || waits[i] > waits[mostStarved]) {
+            mostStarved = i;
+        }
+    }
+
+    out << "  \"events\": {" << endl;
+    out << "    \"contextSwitches\": " << events.getContextSwitches() << "," << endl;
+    out << "    \"preemptions\": " << events.getPreemptions() << "," << endl;
+    out << "    \"queues\": [";
+    for(int queue = 0; queue < events.getNumQueues(); queue++) {
+        out << (queue == 0 ? "" : ",") << "\n      {"
+            << "\"queue\": " << queue + 1 << ", "
+            << "\"meanDepth\": " << events.getMeanQueueDepth(queue) << ", "
+            << "\"maxDepth\": " << events.getMaxQueueDepth(queue) << "}";
+    }
+    out << (events.getNumQueues() == 0 ? "]," : "\n    ],") << endl;
+    out << "    \"longestWait\": ";
+    outputHistogramJson(out, longestWaits);
+    if(mostStarved >= 0) {
+        out << "," << endl << "    \"mostStarved\": {\"id\": \"" << jsonEscape(processes.getId(mostStarved)) << "\", "
+            << "\"longestWait\": " << waits[mostStarved] << "}";
+    }
+    out << endl << "  }," << endl;
+}
+
+/**
+ * Print the memory used by part of a run as a JSON object: the number of allocations, the bytes they requested,
+ * and the most bytes that were allocated at once
+ * @param out The stream to write the object to
+ * @param memory The memory used
+ */
+void outputMemoryJson(ostream& out, const MemoryStatistics& memory) {
+    out << "{\"allocations\": " << memory.allocations << ", "
+        << "\"allocatedBytes\": " << memory.allocatedBytes << ", "
+        << "\"peakBytes\": " << memory.peakBytes << "}";
+}
+
+/**
+ * Print the sampled queue depths of a simulation as CSV: the time, the number of busy CPUs, and the number of
+ * processes waiting in each ready queue (for Multilevel and Multilevel Feedback, one queue per priority level)
+ * @param out The stream to write the samples to
+ * @param events The counters of the finished simulation
+ */
+void outputQueueSamples(ostream& out, const EventCounters& events) {
+    out << "time,busyCpus";
+    for(int queue = 0; queue < events.getNumQueues(); queue++) {
+        out << ",queue" << queue + 1;
+    }
+    out << '\n';
+    for(const QueueDepthSample& sample : events.getSamples()) {
+        out << sample.time << ',' << sample.busyCpus;
+        for(int queue = 0; queue < events.getNumQueues(); queue++) {
+            out << ',' << (static_cast<unsigned int>(queue) < sample.depths.size() ? sample.depths[queue] : 0);
+        }
+        out << '\n';
+    }
+}
+
+/**
+ * Print the distributions of one group's metrics as the members of a JSON object
+ * @param out The stream to write the metrics to
+ * @param metrics The metrics of the group
+ * @param indent The text to start each member's line with
+ */
+void outputLatencyJson(ostream& out, const LatencyMetrics& metrics, const string& indent) {
+    out << indent << "\"turnaroundTime\": ";
+    outputHistogramJson(out, metrics.turnaroundTime);
+    out << "," << endl << indent << "\"normalizedTurnaroundTime\": ";
+    outputHistogramJson(out, metrics.normalizedTurnaroundTime, NORMALIZED_TURNAROUND_SCALE);
+    out << "," << endl << indent << "\"waitingTime\": ";
+    outputHistogramJson(out, metrics.waitingTime);
+    out << "," << endl << indent << "\"responseTime\": ";
+    outputHistogramJson(out, metrics.responseTime);
+}
+
+/**
+ * Print the summary of a distribution as a JSON object: its count, mean, percentiles, and extremes
+ * Percentiles are within 0.1% of the exact values, since the histogram rounds large values to its buckets
+ * @param out The stream to write the summary to
+ * @param histogram The distribution
+ * @param scale The number of recorded units in one unit of the reported values
+ */
+void outputHistogramJson(ostream& out, const LogHistogram& histogram, int scale) {
+    double unit = scale;
+    out << "{\"count\": " << histogram.count()
+        << ", \"mean\": " << histogram.mean() / unit
+        << ", \"min\": " << histogram.smallest() / unit
+        << ", \"p50\": " << histogram.quantile(0.5) / unit
+        << ", \"p90\": " << histogram.quantile(0.9) / unit
+        << ", \"p99\": " << histogram.quantile(0.99) / unit
+        << ", \"p999\": " << histogram.quantile(0.999) / unit
+        << ", \"max\": " << histogram.largest() / unit << "}";
+}
+
+/**
+ * @param text The text to put in a JSON string
+ * @return The text with quotes, backslashes, and control characters escaped
+ */
+string jsonEscape(string_view text) {
+    string escaped;
+    for(char c : text) {
+        if(c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if(static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+            escaped += buffer;
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
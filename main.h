@@ -1,11 +1,93 @@
 #ifndef MAIN_H
 #define MAIN_H
 
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "periodic_tasks.h"
 #include "process.h"
+#include "process_file.h"
+#include "event_counters.h"
+#include "memory_statistics.h"
+#include "process_table.h"
+#include "run_metrics.h"
+#include "scheduler.h"
+#include "simulator.h"
+
+/**
+ * Options for a headless run, taken from command-line flags
+ */
+struct HeadlessOptions {
+    string filename;  // the file containing the list of processes
+    ProcessType processType = NONE;  // the type of processes in the file
+    int schedulerType = -1;  // the number of the scheduling algorithm, as listed by promptForSchedulingAlgorithm
+    int timeQuantum = 10;  // the time quantum for the Round Robin based algorithms
+    string tableFilename;  // where to write the process table, or empty to skip it
+    string ganttFilename;  // where to write the Gantt chart of the run, or empty to skip it
+    int numCpus = 1;  // the number of CPUs to simulate
+    QueueMode queueMode = GLOBAL_QUEUE;  // how the CPUs share the processes that are ready to run
+    bool periodic = false;  // whether realtime processes are periodic tasks that release a job every period
+    int horizon = 0;  // periodic tasks release no jobs at or after this time, or 0 for one hyperperiod
+    bool analyze = false;  // whether to test the periodic tasks for schedulability analytically instead of simulating
+    bool crossCheck = false;  // whether to also simulate the tasks and compare the result with the analysis
+    bool virtualDispatch = false;  // whether the simulation calls the scheduler through its virtual methods
+    string queueSamplesFilename;  // where to write the sampled queue depths, or empty to skip them
+    int sampleInterval = 1;  // the number of time steps between queue depth samples
+    int forkTime = -1;  // the time to fork the simulation at and continue with every scheduler, or -1 to run normally
+    int cpuBurstLength = 0;  // the length of each CPU burst between I/O requests, or 0 to compute in one burst
+    int ioBurstLength = 0;  // the time each I/O request takes to complete
+};
+
+/**
+ * Summary statistics of a finished simulation
+ */
+struct RunStatistics {
+    int numProcesses = 0;  // the number of processes that were simulated
+    int finishTime = 0;  // the time at the end of the simulation
+    int timesIdle = 0;  // the number of clock cycles a CPU was idle, summed over every CPU
+    double idlePercentage = 0;  // the percentage of CPU clock cycles that were idle
+    double meanTurnaroundTime = 0;  // the mean time from arrival to finishing
+    double meanNormalizedTurnaroundTime = 0;  // the mean turnaround time relative to time spent running
+    int metDeadlines = 0;  // the number of realtime processes that finished by their deadline
+    double metDeadlinesPercentage = 0;  // the percentage of realtime processes that finished by their deadline
+    int numCpus = 1;  // the number of CPUs that were simulated
+    int migrations = 0;  // the number of times a process moved to a different CPU
+    vector<double> cpuUtilization;  // the percentage of clock cycles each CPU was running a process
+};
 
-void readProcessFile(const string& filename, const ProcessType processType, vector<Process*>& procList);
 ProcessType promptForProcessType();
 int promptForSchedulingAlgorithm(ProcessType processType);
-void outputStatistics(vector<Process*>& processList, ProcessType selectedProcessType, int timesIdle, int currentTime);
+Scheduler* createScheduler(ProcessType processType, int schedulerType, ProcessTable& processes, int timeQuantum);
+vector<Scheduler*> createSchedulers(ProcessType processType, int schedulerType, ProcessTable& processes, int timeQuantum,
+                                    int numCpus, QueueMode queueMode);
+int runHeadless(int argc, char* argv[]);
+int runForkedBranches(const HeadlessOptions& options, ProcessTable& processes);
+int runSchedulabilityAnalysis(const HeadlessOptions& options, const ProcessTable& tasks);
+void outputHeadlessUsage(ostream& out);
+HeadlessOptions parseHeadlessOptions(int argc, char* argv[]);
+ProcessType processTypeFromName(const string& name);
+string processTypeName(ProcessType processType);
+int schedulerTypeFromName(ProcessType processType, const string& name);
+const vector<string>& schedulerNames(ProcessType processType);
+bool queueModeFromName(const string& name, QueueMode& queueMode);
+string queueModeName(QueueMode queueMode);
+int processColumnWidth(unsigned int numProcesses);
+void outputTableHeader(ostream& out, unsigned int numProcesses, int numCpus = 1);
+void outputTimeStep(ostream& out, const TimeSlice& slice, int time, unsigned int numProcesses);
+void outputStatistics(ProcessTable& processes, ProcessType selectedProcessType, int timesIdle, int currentTime,
+                      const RunMetrics& metrics);
+void outputPercentileRow(const string& name, const LogHistogram& histogram, int scale = 1);
+RunStatistics computeStatistics(ProcessTable& processes, ProcessType selectedProcessType, const SimulatorBase& simulator);
+void outputStatisticsJson(ostream& out, ProcessTable& processes, const HeadlessOptions& options, const SimulatorBase& simulator,
+                          const MemoryStatistics& loadMemory, const MemoryStatistics& simulationMemory,
+                          const vector<PeriodicTaskStatistics>& taskStatistics = {});
+void outputMemoryJson(ostream& out, const MemoryStatistics& memory);
+void outputBurstsJson(ostream& out, const HeadlessOptions& options, const BurstModel& bursts, unsigned int numProcesses);
+void outputEventsJson(ostream& out, ProcessTable& processes, const EventCounters& events);
+void outputQueueSamples(ostream& out, const EventCounters& events);
+void outputLatencyJson(ostream& out, const LatencyMetrics& metrics, const string& indent);
+void outputHistogramJson(ostream& out, const LogHistogram& histogram, int scale = 1);
+string jsonEscape(string_view text);
 
 #endif //MAIN_H
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "memory_statistics.h"
+
+using namespace std;
+
+/**
+ * Counts every allocation made through new and delete, by replacing the global operators
+ * Each block gets a small header holding its size, so that freeing it can be counted as well
+ * The counters are atomic since sweeps allocate from several threads; over-aligned allocations keep the
+ * standard operators and are not counted
+ */
+
+namespace {
+
+const size_t HEADER_SIZE = alignof(max_align_t);  // keeps the memory after the header aligned for any type
+
+atomic<long long> allocations(0);  // the number of allocations made
+atomic<long long> allocatedBytes(0);  // the bytes requested by every allocation made
+atomic<long long> liveBytes(0);  // the bytes allocated and not yet freed
+atomic<long long> peakBytes(0);  // the most bytes that were allocated at once since the last reset
+
+/**
+ * @param size The number of bytes requested
+ * @return The counted block, or nullptr if there is not enough memory
+ */
+void* allocate(size_t size) {
+    void* block = malloc(size + HEADER_SIZE);
+    if(block == nullptr) {
+        return nullptr;
+    }
+    *static_cast<size_t*>(block) = size;
+
+    allocations.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+    long long live = liveBytes.fetch_add(size, memory_order_relaxed) + size;
+    long long peak = peakBytes.load(memory_order_relaxed);
+    while(live > peak && !peakBytes.compare_exchange_weak(peak, live, memory_order_relaxed)) {}
+
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+/**
+ * @param memory A block returned by allocate(), or nullptr
+ */
+void deallocate(void* memory) {
+    if(memory == nullptr) {
+        return;
+    }
+    void* block = static_cast<char*>(memory) - HEADER_SIZE;
+    liveBytes.fetch_sub(*static_cast<size_t*>(block), memory_order_relaxed);
+    free(block);
+}
+
+/**
+ * @param size The number of bytes requested
+ * @return The counted block, terminating through bad_alloc if there is not enough memory
+ */
+void* allocateOrThrow(size_t size) {
+    void* memory = allocate(size);
+    if(memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+}
+
+void* operator new(size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(size_t size, const nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](size_t size, const nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    deallocate(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    deallocate(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    deallocate(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+    deallocate(memory);
+}
+
+void operator delete(void* memory, const nothrow_t&) noexcept {
+    deallocate(memory);
+}
+
+void operator delete[](void* memory, const nothrow_t&) noexcept {
+    deallocate(memory);
+}
+
+/**
+ * @return The allocations made since the program started, and the peak since the last call to resetPeakMemory()
+ */
+MemoryStatistics currentMemoryStatistics() {
+    MemoryStatistics statistics;
+    statistics.allocations = allocations.load(memory_order_relaxed);
+    statistics.allocatedBytes = allocatedBytes.load(memory_order_relaxed);
+    statistics.liveBytes = liveBytes.load(memory_order_relaxed);
+    statistics.peakBytes = peakBytes.load(memory_order_relaxed);
+    return statistics;
+}
+
+/**
+ * @param start The statistics at an earlier point, when resetPeakMemory() was called
+ * @return The allocations made and bytes allocated since then, the change in live bytes, and the most bytes
+ *         that were allocated at once since then, over what was live at the start
+ */
+MemoryStatistics memoryUsedSince(const MemoryStatistics& start) {
+    MemoryStatistics now = currentMemoryStatistics();
+    MemoryStatistics used;
+    used.allocations = now.allocations - start.allocations;
+    used.allocatedBytes = now.allocatedBytes - start.allocatedBytes;
+    used.liveBytes = now.liveBytes - start.liveBytes;
+    used.peakBytes = now.peakBytes - start.liveBytes;
+    return used;
+}
+
+/**
+ * Starts measuring the peak from the bytes that are allocated now
+ */
+void resetPeakMemory() {
+    peakBytes.store(liveBytes.load(memory_order_relaxed), memory_order_relaxed);
+}
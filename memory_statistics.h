@@ -0,0 +1,20 @@
+#ifndef MEMORY_STATISTICS_H
+#define MEMORY_STATISTICS_H
+
+using namespace std;
+
+/**
+ * Data structure for the heap memory the program has allocated through new
+ */
+struct MemoryStatistics {
+    long long allocations = 0;  // the number of allocations made
+    long long allocatedBytes = 0;  // the bytes requested by every allocation made
+    long long liveBytes = 0;  // the bytes allocated and not yet freed
+    long long peakBytes = 0;  // the most bytes that were allocated at once
+};
+
+MemoryStatistics currentMemoryStatistics();
+MemoryStatistics memoryUsedSince(const MemoryStatistics& start);
+void resetPeakMemory();
+
+#endif //MEMORY_STATISTICS_H
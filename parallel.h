@@ -0,0 +1,48 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @return The number of threads to use when none was requested, based on the number of cores
+ */
+inline unsigned int defaultThreadCount() {
+    return max(1u, thread::hardware_concurrency());
+}
+
+/**
+ * Runs a task for every index from 0 to count - 1 on a pool of worker threads
+ * Each worker repeatedly claims the next unclaimed index, so long tasks do not hold up the others
+ * Returns once every task has finished
+ * @param count The number of tasks
+ * @param numThreads The number of worker threads to use
+ * @param task The task to run, given the index it should work on
+ */
+inline void parallelFor(unsigned int count, unsigned int numThreads, const function<void(unsigned int)>& task) {
+
+    atomic<unsigned int> nextIndex(0);
+    auto worker = [&]() {
+        for(unsigned int i = nextIndex++; i < count; i = nextIndex++) {
+            task(i);
+        }
+    };
+
+    numThreads = max(1u, min(numThreads, count));
+    vector<thread> workers;
+    for(unsigned int i = 1; i < numThreads; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();  // the calling thread works too
+
+    for(unsigned int i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+#endif //PARALLEL_H
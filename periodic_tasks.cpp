@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <numeric>
+#include <queue>
+
+#include "periodic_tasks.h"
+
+using namespace std;
+
+/**
+ * Data structure for the next job of a task in the release queue
+ */
+struct PendingRelease {
+    int time;  // when the job is released
+    int task;  // the index of the task in the task table
+};
+
+/**
+ * Orders the release queue so that the earliest release is on top, breaking ties by task
+ */
+struct LaterRelease {
+    bool operator()(const PendingRelease& a, const PendingRelease& b) const {
+        return a.time > b.time || (a.time == b.time && a.task > b.task);
+    }
+};
+
+/**
+ * Compute the hyperperiod of a set of periodic tasks, after which their releases repeat
+ * Tasks without a positive period only release one job, so they are left out
+ * @param tasks The table of realtime tasks
+ * @return The least common multiple of the periods, 1 if no task is periodic, or -1 if it exceeds INT_MAX
+ */
+long long hyperperiod(const ProcessTable& tasks) {
+    long long result = 1;
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        if(tasks.period[i] > 0) {
+            result = result / gcd(result, static_cast<long long>(tasks.period[i])) * tasks.period[i];
+            if(result > INT_MAX) {
+                return -1;
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Compute the default length of a periodic simulation: one hyperperiod after the last task starts
+ * Terminates the program if that does not fit in the simulation's clock
+ * @param tasks The table of realtime tasks
+ * @return The time before which jobs are released
+ */
+int defaultPeriodicHorizon(const ProcessTable& tasks) {
+    long long length = hyperperiod(tasks);
+    int lastStart = 0;
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        lastStart = max(lastStart, tasks.arrivalTime[i]);
+    }
+    if(length < 0 || lastStart + length > INT_MAX) {
+        cerr << "The hyperperiod of the tasks is too long to simulate; give a shorter horizon with --horizon" << endl;
+        exit(-1);
+    }
+    return lastStart + length;
+}
+
+/**
+ * Turn a table of periodic realtime tasks into the table of jobs they release
+ * A task first releases a job at its arrival time and then once every period; its deadline is taken as
+ * relative to its arrival, so each job must finish by its release time plus that distance
+ * Releases come from a queue holding the next release of every task, so the jobs are produced in order of
+ * release in O(jobs * log(tasks)) time, which lets the simulator skip sorting them
+ * Jobs share the id of their task
+ * @param tasks The table of realtime tasks
+ * @param horizon No jobs are released at or after this time
+ * @param jobs The table to fill with the released jobs
+ * @param jobTasks Filled with the index of the task that released each job
+ */
+void releasePeriodicJobs(const ProcessTable& tasks, int horizon, ProcessTable& jobs, vector<int>& jobTasks) {
+
+    // Count the jobs first so that every column is allocated once
+    long long numJobs = 0;
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        if(tasks.arrivalTime[i] >= 0 && tasks.arrivalTime[i] < horizon) {
+            numJobs += tasks.period[i] > 0 ? (horizon - tasks.arrivalTime[i] + tasks.period[i] - 1LL) / tasks.period[i] : 1;
+        }
+    }
+    if(numJobs > INT_MAX) {
+        cerr << "The tasks release " << numJobs << " jobs before time " << horizon
+             << ", which is too many to simulate; give a shorter horizon with --horizon" << endl;
+        exit(-1);
+    }
+
+    jobs = ProcessTable(REALTIME);
+    jobs.ids = tasks.ids;
+    jobs.resize(numJobs);
+    jobTasks.resize(numJobs);
+
+    priority_queue<PendingRelease, vector<PendingRelease>, LaterRelease> releases;
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        if(tasks.arrivalTime[i] >= 0 && tasks.arrivalTime[i] < horizon) {
+            releases.push(PendingRelease{tasks.arrivalTime[i], static_cast<int>(i)});
+        }
+    }
+
+    for(unsigned int j = 0; !releases.empty(); j++) {
+        PendingRelease release = releases.top();
+        releases.pop();
+        int task = release.task;
+
+        jobs.idIndex[j] = tasks.idIndex[task];
+        jobs.arrivalTime[j] = release.time;
+        jobs.totalTimeNeeded[j] = tasks.totalTimeNeeded[task];
+        jobs.period[j] = tasks.period[task];
+        jobs.deadline[j] = release.time + (tasks.deadline[task] - tasks.arrivalTime[task]);
+        jobTasks[j] = task;
+
+        // queue the task's next job, unless it is past the horizon
+        if(tasks.period[task] > 0 && static_cast<long long>(release.time) + tasks.period[task] < horizon) {
+            releases.push(PendingRelease{release.time + tasks.period[task], task});
+        }
+    }
+}
+
+/**
+ * Summarize the jobs of every task after a periodic simulation
+ * @param tasks The table of realtime tasks
+ * @param jobs The table of finished jobs
+ * @param jobTasks The index of the task that released each job
+ * @return The statistics of each task
+ */
+vector<PeriodicTaskStatistics> computeTaskStatistics(const ProcessTable& tasks, const ProcessTable& jobs, const vector<int>& jobTasks) {
+
+    vector<PeriodicTaskStatistics> statistics(tasks.size());
+    for(unsigned int i = 0; i < tasks.size(); i++) {
+        statistics[i].id = tasks.getId(i);
+    }
+
+    for(unsigned int j = 0; j < jobs.size(); j++) {
+        PeriodicTaskStatistics& task = statistics[jobTasks[j]];
+        int turnaroundTime = jobs.timeFinished[j] - jobs.arrivalTime[j];
+
+        task.numJobs++;
+        task.worstTurnaroundTime = max(task.worstTurnaroundTime, turnaroundTime);
+        task.meanTurnaroundTime += turnaroundTime;
+        if(jobs.timeFinished[j] > jobs.deadline[j]) {
+            task.missedDeadlines++;
+        }
+    }
+
+    for(PeriodicTaskStatistics& task : statistics) {
+        if(task.numJobs > 0) {
+            task.meanTurnaroundTime /= task.numJobs;
+        }
+    }
+
+    return statistics;
+}
@@ -0,0 +1,27 @@
+#ifndef PERIODIC_TASKS_H
+#define PERIODIC_TASKS_H
+
+#include <string>
+#include <vector>
+
+#include "process_table.h"
+
+using namespace std;
+
+/**
+ * Summary of the jobs released by one periodic task
+ */
+struct PeriodicTaskStatistics {
+    string id;  // the id of the task
+    int numJobs = 0;  // the number of jobs the task released
+    int missedDeadlines = 0;  // the number of jobs that finished after their deadline
+    int worstTurnaroundTime = 0;  // the longest time from a job's release to it finishing
+    double meanTurnaroundTime = 0;  // the mean time from a job's release to it finishing
+};
+
+long long hyperperiod(const ProcessTable& tasks);
+int defaultPeriodicHorizon(const ProcessTable& tasks);
+void releasePeriodicJobs(const ProcessTable& tasks, int horizon, ProcessTable& jobs, vector<int>& jobTasks);
+vector<PeriodicTaskStatistics> computeTaskStatistics(const ProcessTable& tasks, const ProcessTable& jobs, const vector<int>& jobTasks);
+
+#endif //PERIODIC_TASKS_H
@@ -0,0 +1,163 @@
+#ifndef PROCESS_BEHAVIOR_H
+#define PROCESS_BEHAVIOR_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+using namespace std;
+
+/**
+ * The two things a process can do between scheduling decisions
+ */
+enum BurstKind {
+    CPU_BURST,  // the process computes, and needs a CPU
+    IO_BURST  // the process waits for a device, and leaves its CPU for other processes
+};
+
+/**
+ * Data structure for one burst of a process
+ */
+struct Burst {
+    BurstKind kind = CPU_BURST;  // whether the process computes or waits for I/O
+    int length = 0;  // the number of time steps the burst lasts
+};
+
+/**
+ * @param length The number of time steps of computation
+ * @return A CPU burst, for a behavior to co_yield
+ */
+inline Burst cpuBurst(int length) {
+    return Burst{CPU_BURST, length};
+}
+
+/**
+ * @param length The number of time steps until the device completes the request
+ * @return An I/O burst, for a behavior to co_yield
+ */
+inline Burst ioBurst(int length) {
+    return Burst{IO_BURST, length};
+}
+
+/**
+ * What a process does over its lifetime, written as a C++20 coroutine that co_yields its bursts in order
+ * The coroutine is suspended between bursts and only resumed by the simulator when it needs the next one: when
+ * the process arrives, when a CPU burst has run to its end, and when the device completes an I/O burst
+ * A suspended process is a single heap-allocated coroutine frame holding its local variables, with no thread or
+ * stack of its own, so millions of processes can be in the middle of their behaviors at once
+ * Owns its coroutine frame, which is destroyed with it
+ */
+class ProcessBehavior {
+
+public:
+
+    /**
+     * The state the coroutine shares with its caller, required by the language for a coroutine return type
+     */
+    struct promise_type {
+
+        Burst burst;  // the burst the coroutine last yielded
+
+        ProcessBehavior get_return_object() {
+            return ProcessBehavior(coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // the behavior does nothing until the simulator first asks for a burst
+        suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        // the frame stays alive after the last burst, so that done() can be checked, until the owner destroys it
+        suspend_always final_suspend() noexcept {
+            return {};
+        }
+
+        suspend_always yield_value(Burst next) noexcept {
+            burst = next;
+            return {};
+        }
+
+        void return_void() noexcept {}
+
+        void unhandled_exception() {
+            terminate();
+        }
+
+    };
+
+    /**
+     * Constructor for a process without a behavior
+     */
+    ProcessBehavior() = default;
+
+    ProcessBehavior(ProcessBehavior&& other) noexcept : handle(exchange(other.handle, nullptr)) {}
+
+    ProcessBehavior& operator=(ProcessBehavior&& other) noexcept {
+        if(this != &other) {
+            destroy();
+            handle = exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ProcessBehavior(const ProcessBehavior&) = delete;
+    ProcessBehavior& operator=(const ProcessBehavior&) = delete;
+
+    ~ProcessBehavior() {
+        destroy();
+    }
+
+    /**
+     * Runs the behavior up to its next burst
+     * @param burst Set to the next burst, if there is one
+     * @return Whether there was another burst, rather than the behavior having finished
+     */
+    bool next(Burst& burst) {
+        if(!handle || handle.done()) {
+            return false;
+        }
+        handle.resume();
+        if(handle.done()) {
+            return false;
+        }
+        burst = handle.promise().burst;
+        return true;
+    }
+
+    /**
+     * Frees the coroutine frame, leaving the process without a behavior
+     */
+    void destroy() {
+        if(handle) {
+            handle.destroy();
+            handle = nullptr;
+        }
+    }
+
+private:
+
+    coroutine_handle<promise_type> handle;  // the suspended coroutine, or null
+
+    explicit ProcessBehavior(coroutine_handle<promise_type> handle) : handle(handle) {}
+
+};
+
+/**
+ * The behavior of a process that computes in bursts of the same length with an I/O request after each one,
+ * such as a request handler that reads from disk between pieces of work
+ * @param computationTime The total time the process computes for
+ * @param cpuLength The length of each CPU burst; the last one is shorter if the computation time runs out
+ * @param ioLength The time each I/O request takes to complete
+ * @return The behavior
+ */
+inline ProcessBehavior alternatingBursts(int computationTime, int cpuLength, int ioLength) {
+    int remaining = computationTime;
+    while(remaining > cpuLength) {
+        co_yield cpuBurst(cpuLength);
+        co_yield ioBurst(ioLength);
+        remaining -= cpuLength;
+    }
+    co_yield cpuBurst(remaining);
+}
+
+#endif //PROCESS_BEHAVIOR_H
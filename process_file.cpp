@@ -0,0 +1,439 @@
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "process_file.h"
+#include "binary_workload.h"
+#include "parallel.h"
+#include "sched_trace.h"
+
+using namespace std;
+
+const size_t MIN_CHUNK_SIZE = 1 << 22;  // files are only split into chunks of at least 4 MiB
+const unsigned int MAX_REPORTED_ERRORS = 10;  // the number of malformed lines printed before giving up
+
+MappedFile::MappedFile(const string& filename) {
+
+#ifndef _WIN32
+    int descriptor = open(filename.c_str(), O_RDONLY);
+    struct stat status;
+    if(descriptor < 0 || fstat(descriptor, &status) != 0) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    length = status.st_size;
+    if(length > 0) {
+        void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if(mapping != MAP_FAILED) {
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+            mapped = true;
+        }
+    }
+    close(descriptor);
+    if(mapped || length == 0) {
+        return;
+    }
+#endif
+
+    // Fall back to reading the whole file when it cannot be mapped
+    ifstream in(filename.c_str(), ios::binary);
+    if(in.fail()) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+    buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = buffer.data();
+    length = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if(mapped) {
+        munmap(const_cast<char*>(data), length);
+    }
+#endif
+}
+
+/**
+ * @return Whether a character separates the fields of a line
+ */
+static bool isFieldSeparator(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * Read in data from a file and interpret it as a list of processes of a certain type
+ * The first line of the file indicates the number of processes
+ * Each following line represents a process with information such as the process id, arrival time,
+ * required processing time, and additional data specific to the process type
+ * The file is memory-mapped and large files are split into chunks that are parsed in parallel
+ * Binary workload files are recognized by their first bytes and loaded without parsing, and scheduler traces
+ * (perf sched script or ftrace dumps) by their events, which are turned into one process per CPU burst
+ * Malformed lines, and a process count that does not match the first line, are reported with their line
+ * numbers and terminate the program
+ * @param fname The name of the file to read from
+ * @param processType The type of processes in the given file
+ * @param processes The table representation of all the processes
+ * @post processes is filled with the processes from the file
+ */
+void readProcessFile(const string& fname, const ProcessType processType, ProcessTable& processes) {
+
+    if(processType != BATCH && processType != INTERACTIVE && processType != REALTIME) {
+        cerr << "Invalid process type supplied: " << processType << endl;
+        exit(-1);
+    }
+
+    MappedFile file(fname);
+    const char* position = file.begin();
+    const char* end = file.end();
+
+    if(isBinaryWorkload(position, end)) {
+        readBinaryWorkload(fname, position, end, processType, processes);
+        return;
+    }
+    if(isSchedTrace(position, end)) {
+        readSchedTraceWorkload(fname, processType, processes);
+        return;
+    }
+
+    // The header is the first non-blank line
+    unsigned int headerLine = 1;
+    while(position != end && (isFieldSeparator(*position) || *position == '\n')) {
+        headerLine += *position == '\n';
+        position++;
+    }
+    int numProcesses = 0;
+    bool validHeader = parseInteger(position, end, numProcesses) && numProcesses >= 0;
+    while(position != end && isFieldSeparator(*position)) {
+        position++;
+    }
+    if(!validHeader || (position != end && *position != '\n')) {
+        cerr << fname << ":" << headerLine << ": expected the number of processes, terminating program" << endl;
+        exit(-1);
+    }
+    if(position != end) {
+        position++;  // the processes start on the next line
+    }
+
+    // Split the rest of the file into chunks that end on line boundaries
+    size_t bodyLength = end - position;
+    unsigned int numChunks = max<size_t>(1, min<size_t>(defaultThreadCount(), bodyLength / MIN_CHUNK_SIZE));
+    vector<ProcessFileChunk> chunks(numChunks);
+    for(unsigned int c = 0; c < numChunks; c++) {
+        chunks[c].begin = c == 0 ? position : chunks[c - 1].end;
+        chunks[c].end = c == numChunks - 1 ? end : max(chunks[c].begin, position + bodyLength * (c + 1) / numChunks);
+        chunks[c].end = find(chunks[c].end, end, '\n');
+        if(chunks[c].end != end) {
+            chunks[c].end++;  // include the newline
+        }
+    }
+
+    parallelFor(numChunks, numChunks, [&](unsigned int c) {
+        parseProcessChunk(chunks[c], processType);
+    });
+
+    // Report malformed lines with their line numbers in the whole file
+    unsigned int lineOffset = headerLine;
+    unsigned int numErrors = 0;
+    unsigned int numParsed = 0;
+    for(unsigned int c = 0; c < numChunks; c++) {
+        for(unsigned int e = 0; e < chunks[c].errors.size() && numErrors + e < MAX_REPORTED_ERRORS; e++) {
+            cerr << fname << ":" << lineOffset + chunks[c].errors[e].first << ": " << chunks[c].errors[e].second << endl;
+        }
+        numErrors += chunks[c].numErrors;
+        lineOffset += chunks[c].numLines;
+        numParsed += chunks[c].processes.size();
+    }
+
+    if(numErrors > 0) {
+        cerr << "Found " << numErrors << " malformed line" << (numErrors == 1 ? "" : "s")
+             << " in \"" << fname << "\", terminating program" << endl;
+        exit(-1);
+    }
+    if(numParsed != static_cast<unsigned int>(numProcesses)) {
+        cerr << fname << ":" << headerLine << ": the file declares " << numProcesses << " processes but lists "
+             << numParsed << ", terminating program" << endl;
+        exit(-1);
+    }
+
+    // A single chunk already holds the columns in order
+    if(numChunks == 1) {
+        processes = move(chunks[0].processes);
+        processes.resize(numProcesses);  // add the columns that are not read from the file
+        return;
+    }
+
+    // Copy every chunk into its place in the table
+    processes = ProcessTable(processType);
+    processes.resize(numProcesses);
+    vector<unsigned int> offsets(numChunks, 0);
+    for(unsigned int c = 1; c < numChunks; c++) {
+        offsets[c] = offsets[c - 1] + chunks[c - 1].processes.size();
+    }
+
+    // Every process in a chunk has its own id, so a chunk's ids start at the same offset as its processes
+    for(unsigned int c = 0; c < numChunks; c++) {
+        const IdTable& chunkIds = chunks[c].processes.ids;
+        uint64_t textOffset = processes.ids.text.size();
+        processes.ids.text += chunkIds.text;
+        for(unsigned int i = 1; i < chunkIds.offsets.size(); i++) {
+            processes.ids.offsets.push_back(textOffset + chunkIds.offsets[i]);
+        }
+    }
+
+    parallelFor(numChunks, numChunks, [&](unsigned int c) {
+        ProcessTable& chunk = chunks[c].processes;
+        for(unsigned int i = 0; i < chunk.size(); i++) {
+            processes.idIndex[offsets[c] + i] = offsets[c] + chunk.idIndex[i];
+        }
+        copy(chunk.arrivalTime.begin(), chunk.arrivalTime.end(), processes.arrivalTime.begin() + offsets[c]);
+        copy(chunk.totalTimeNeeded.begin(), chunk.totalTimeNeeded.end(), processes.totalTimeNeeded.begin() + offsets[c]);
+        if(processType == INTERACTIVE) {
+            copy(chunk.priority.begin(), chunk.priority.end(), processes.priority.begin() + offsets[c]);
+        } else if(processType == REALTIME) {
+            copy(chunk.period.begin(), chunk.period.end(), processes.period.begin() + offsets[c]);
+            copy(chunk.deadline.begin(), chunk.deadline.end(), processes.deadline.begin() + offsets[c]);
+        }
+    });
+}
+
+/**
+ * Detect the type of processes in a file from the number of fields in its first process
+ * Batch processes have 3 fields, interactive processes have 4, and realtime processes have 5
+ * Binary workload files store their type in their header, and scheduler traces are interactive, since they
+ * carry the priority of every thread
+ * @param filename The process file
+ * @return The detected process type, terminating the program if it cannot be detected
+ */
+ProcessType detectProcessType(const string& filename) {
+
+    ifstream in(filename.c_str(), ios::binary);
+    string line;
+
+    if(in.fail()) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    BinaryWorkloadHeader header;
+    if(in.read(reinterpret_cast<char*>(&header), sizeof(header)) && isBinaryWorkload(header.magic, header.magic + 4)) {
+        return static_cast<ProcessType>(header.processType);
+    }
+    in.clear();
+    in.seekg(0);
+
+    if(isSchedTraceFile(filename)) {
+        return INTERACTIVE;
+    }
+
+    getline(in, line);  // the number of processes
+    while(getline(in, line)) {
+        istringstream fields(line);
+        string field;
+        int numFields = 0;
+        while(fields >> field) {
+            numFields++;
+        }
+
+        if(numFields == 3) {
+            return BATCH;
+        } else if(numFields == 4) {
+            return INTERACTIVE;
+        } else if(numFields == 5) {
+            return REALTIME;
+        } else if(numFields > 0) {
+            break;
+        }
+    }
+
+    cerr << "Unable to detect the process type of \"" << filename << "\"; use --type" << endl;
+    exit(-1);
+}
+
+/**
+ * Write a table of processes to a file in the text format read by readProcessFile
+ * @param filename The name of the file to write to
+ * @param processes The processes to write
+ */
+void writeProcessFile(const string& filename, const ProcessTable& processes) {
+
+    ofstream out;
+    vector<char> buffer(1 << 20);  // large writes keep the output from dominating the run time
+    out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    out.open(filename.c_str());
+
+    if(out.fail()) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    out << processes.size() << '\n';
+    for(unsigned int i = 0; i < processes.size(); i++) {
+        out << processes.getId(i) << ' ' << processes.arrivalTime[i] << ' ' << processes.totalTimeNeeded[i];
+        if(processes.processType == INTERACTIVE) {
+            out << ' ' << processes.priority[i];
+        } else if(processes.processType == REALTIME) {
+            out << ' ' << processes.period[i] << ' ' << processes.deadline[i];
+        }
+        out << '\n';
+    }
+
+    out.close();
+    if(out.fail()) {
+        cerr << "Failed to write \"" << filename << "\"" << endl;
+        exit(-1);
+    }
+}
+
+/**
+ * Parse the process lines in one chunk of a process file
+ * Blank lines are skipped, and each other line must hold exactly the fields of the process type
+ * @param chunk The chunk to parse; only the columns that are read from the file are filled in
+ * @param processType The type of processes in the file
+ */
+void parseProcessChunk(ProcessFileChunk& chunk, ProcessType processType) {
+
+    static const string batchFields[] = {"arrival time", "computation time"};
+    static const string interactiveFields[] = {"arrival time", "computation time", "priority"};
+    static const string realtimeFields[] = {"arrival time", "computation time", "period", "deadline"};
+
+    const string* fieldNames = batchFields;
+    unsigned int numFields = 2;
+    if(processType == INTERACTIVE) {
+        fieldNames = interactiveFields;
+        numFields = 3;
+    } else if(processType == REALTIME) {
+        fieldNames = realtimeFields;
+        numFields = 4;
+    }
+
+    ProcessTable& processes = chunk.processes;
+    processes.processType = processType;
+    const char* position = chunk.begin;
+    int values[4];
+
+    // Counting the lines first lets every column be allocated once
+    size_t maxProcesses = count(chunk.begin, chunk.end, '\n') + 1;
+    processes.idIndex.reserve(maxProcesses);
+    processes.ids.offsets.reserve(maxProcesses + 1);
+    processes.arrivalTime.reserve(maxProcesses);
+    processes.totalTimeNeeded.reserve(maxProcesses);
+    if(processType == INTERACTIVE) {
+        processes.priority.reserve(maxProcesses);
+    } else if(processType == REALTIME) {
+        processes.period.reserve(maxProcesses);
+        processes.deadline.reserve(maxProcesses);
+    }
+
+    while(position != chunk.end) {
+        chunk.numLines++;
+
+        while(position != chunk.end && isFieldSeparator(*position)) {
+            position++;
+        }
+
+        if(position == chunk.end || *position == '\n') {
+            // blank line
+        } else {
+            // The process id is everything up to the next separator
+            const char* idBegin = position;
+            while(position != chunk.end && !isFieldSeparator(*position) && *position != '\n') {
+                position++;
+            }
+            const char* idEnd = position;
+
+            string error;
+            for(unsigned int f = 0; f < numFields && error.empty(); f++) {
+                while(position != chunk.end && isFieldSeparator(*position)) {
+                    position++;
+                }
+                if(!parseInteger(position, chunk.end, values[f])) {
+                    error = "expected an integer " + fieldNames[f];
+                }
+            }
+            while(error.empty() && position != chunk.end && isFieldSeparator(*position)) {
+                position++;
+            }
+            if(error.empty() && position != chunk.end && *position != '\n') {
+                error = "too many fields, expected " + to_string(numFields + 1);
+            }
+            if(error.empty() && values[0] < 0) {
+                error = "the arrival time cannot be negative";
+            } else if(error.empty() && values[1] < 1) {
+                error = "the computation time must be at least 1";
+            }
+
+            if(!error.empty()) {
+                if(chunk.errors.size() < MAX_REPORTED_ERRORS) {
+                    chunk.errors.push_back(make_pair(chunk.numLines, error));
+                }
+                chunk.numErrors++;
+            } else {
+                processes.idIndex.push_back(processes.ids.add(string_view(idBegin, idEnd - idBegin)));
+                processes.arrivalTime.push_back(values[0]);
+                processes.totalTimeNeeded.push_back(values[1]);
+                if(processType == INTERACTIVE) {
+                    processes.priority.push_back(values[2]);
+                } else if(processType == REALTIME) {
+                    processes.period.push_back(values[2]);
+                    processes.deadline.push_back(values[3]);
+                }
+            }
+        }
+
+        // move on to the next line
+        position = find(position, chunk.end, '\n');
+        if(position != chunk.end) {
+            position++;
+        }
+    }
+}
+
+/**
+ * Parse a decimal integer that is followed by a separator, a newline, or the end of the input
+ * @param position The first character of the integer; moved past the integer if it is valid
+ * @param end One past the last character of the input
+ * @param value Set to the parsed integer
+ * @return Whether a valid integer that fits in an int was found
+ */
+bool parseInteger(const char*& position, const char* end, int& value) {
+
+    const char* current = position;
+    bool negative = current != end && *current == '-';
+    if(negative) {
+        current++;
+    }
+
+    const char* digitsBegin = current;
+    long long magnitude = 0;
+    while(current != end && *current >= '0' && *current <= '9') {
+        magnitude = magnitude * 10 + (*current - '0');
+        if(magnitude > static_cast<long long>(INT_MAX) + 1) {
+            return false;  // too large for an int
+        }
+        current++;
+    }
+
+    if(current == digitsBegin || (current != end && !isFieldSeparator(*current) && *current != '\n')) {
+        return false;
+    }
+    if(!negative && magnitude > INT_MAX) {
+        return false;
+    }
+
+    value = static_cast<int>(negative ? -magnitude : magnitude);
+    position = current;
+    return true;
+}
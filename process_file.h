@@ -0,0 +1,75 @@
+#ifndef PROCESS_FILE_H
+#define PROCESS_FILE_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "process.h"
+#include "process_table.h"
+
+using namespace std;
+
+/**
+ * Read-only view of the contents of a file
+ * On POSIX systems the file is memory-mapped, so the parser reads straight from the page cache without
+ * copying; elsewhere the file is read into a buffer
+ */
+class MappedFile {
+
+public:
+
+    /**
+     * Opens and maps a file, terminating the program if it cannot be read
+     * @param filename The name of the file
+     */
+    explicit MappedFile(const string& filename);
+
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @return The first character of the file
+     */
+    const char* begin() const {
+        return data;
+    }
+
+    /**
+     * @return One past the last character of the file
+     */
+    const char* end() const {
+        return data + length;
+    }
+
+private:
+
+    const char* data = nullptr;  // the contents of the file
+    size_t length = 0;  // the number of characters in the file
+    bool mapped = false;  // whether data is a memory mapping that must be unmapped
+    vector<char> buffer;  // holds the contents when the file is not memory-mapped
+
+};
+
+/**
+ * Data structure for the processes parsed from one chunk of a process file
+ * Chunks are parsed independently and then copied into the process table in order
+ */
+struct ProcessFileChunk {
+    const char* begin = nullptr;  // the first character of the chunk, which starts a line
+    const char* end = nullptr;  // one past the last character of the chunk, which ends a line
+    unsigned int numLines = 0;  // the number of lines in the chunk, including blank and malformed ones
+    ProcessTable processes;  // the processes in the chunk (only the columns read from the file)
+    vector<pair<unsigned int, string>> errors;  // line within the chunk and description of the first malformed lines
+    unsigned int numErrors = 0;  // the number of malformed lines, including ones left out of errors
+};
+
+void readProcessFile(const string& filename, const ProcessType processType, ProcessTable& processes);
+ProcessType detectProcessType(const string& filename);
+void writeProcessFile(const string& filename, const ProcessTable& processes);
+void parseProcessChunk(ProcessFileChunk& chunk, ProcessType processType);
+bool parseInteger(const char*& position, const char* end, int& value);
+
+#endif //PROCESS_FILE_H
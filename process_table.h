@@ -0,0 +1,205 @@
+#ifndef PROCESS_TABLE_H
+#define PROCESS_TABLE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "process.h"
+
+using namespace std;
+
+/**
+ * Table of distinct process ids, stored one after another in a single string
+ * Processes refer to their id by its index, so an id shared by many processes is stored once, and the whole
+ * table can be read from or written to a file in bulk
+ */
+class IdTable {
+
+public:
+
+    string text;  // every distinct id, one after another
+    vector<uint64_t> offsets = vector<uint64_t>(1, 0);  // where each id starts in text, then the end of the last id
+
+    /**
+     * @return The number of distinct ids
+     */
+    unsigned int size() const {
+        return offsets.size() - 1;
+    }
+
+    /**
+     * Adds an id to the end of the table
+     * @param name The text of the id
+     * @return The index of the new id
+     */
+    unsigned int add(string_view name) {
+        text.append(name.data(), name.size());
+        offsets.push_back(text.size());
+        return size() - 1;
+    }
+
+    /**
+     * @param index The index of an id
+     * @return The text of the id
+     */
+    string_view operator[](unsigned int index) const {
+        return string_view(text.data() + offsets[index], offsets[index + 1] - offsets[index]);
+    }
+
+};
+
+/**
+ * Table of all the processes in a simulation, stored as a structure of arrays
+ * Every field has its own contiguous column, and a process is identified by its index into the columns
+ * Scanning one field of every process is a sequential pass over a single array instead of a pointer chase
+ * The columns that only apply to one type of process (priority, period, and deadline) are left empty for
+ * the other types
+ */
+class ProcessTable {
+
+public:
+
+    static const unsigned char ARRIVED = 1;  // flag for whether the process has arrived at the CPU
+    static const unsigned char DONE = 2;  // flag for whether the process has finished computing
+    static const unsigned char BLOCKED = 4;  // flag for whether the process is waiting for I/O to complete
+
+    ProcessType processType = NONE;  // the type of every process in the table
+
+    IdTable ids;  // the distinct process ids
+    vector<unsigned int> idIndex;  // index in ids of the identifier for the process
+    vector<int> arrivalTime;  // the time that the process arrives at the CPU
+    vector<int> timeScheduled;  // the amount of time the process has run on the CPU so far
+    vector<int> totalTimeNeeded;  // the total amount of time the process needs to run
+    vector<int> timeFinished;  // the time that the process finishes (-1 if not finished yet)
+    vector<unsigned char> flags;  // ARRIVED, DONE, and BLOCKED flags for the process
+    vector<int> priority;  // priority of an interactive process
+    vector<int> period;  // the period, or how often a realtime process should run
+    vector<int> deadline;  // the deadline, the CPU time a realtime process must finish by
+
+    /**
+     * Constructor for an empty table
+     * @param processType The type of processes the table holds
+     */
+    explicit ProcessTable(ProcessType processType = NONE) : processType(processType) {}
+
+    /**
+     * @return The number of processes in the table
+     */
+    unsigned int size() const {
+        return arrivalTime.size();
+    }
+
+    /**
+     * @return Whether the table has no processes
+     */
+    bool empty() const {
+        return arrivalTime.empty();
+    }
+
+    /**
+     * Resizes every column that applies to the table's process type
+     * New processes have not arrived, have not run, and have default type-specific fields
+     * @param numProcesses The number of processes the table should hold
+     */
+    void resize(unsigned int numProcesses) {
+        idIndex.resize(numProcesses, 0);
+        arrivalTime.resize(numProcesses, -1);
+        timeScheduled.resize(numProcesses, 0);
+        totalTimeNeeded.resize(numProcesses, 0);
+        timeFinished.resize(numProcesses, -1);
+        flags.resize(numProcesses, 0);
+        if(processType == INTERACTIVE) {
+            priority.resize(numProcesses, 1);
+        } else if(processType == REALTIME) {
+            period.resize(numProcesses, 0);
+            deadline.resize(numProcesses, 0);
+        }
+    }
+
+    /**
+     * @param index The index of a process
+     * @return The identifier for the process
+     */
+    string_view getId(int index) const {
+        return ids[idIndex[index]];
+    }
+
+    /**
+     * @param index The index of a process
+     * @return Whether the process has arrived at the CPU
+     */
+    bool hasArrived(int index) const {
+        return flags[index] & ARRIVED;
+    }
+
+    /**
+     * @param index The index of a process
+     * @return Whether the process has finished computing
+     */
+    bool isDone(int index) const {
+        return flags[index] & DONE;
+    }
+
+    /**
+     * @param index The index of a process
+     * @return Whether the process is waiting for I/O to complete, and so cannot run
+     */
+    bool isBlocked(int index) const {
+        return flags[index] & BLOCKED;
+    }
+
+    /**
+     * @param index The index of a process
+     * @return Whether the process can keep a CPU: it has neither finished nor left to wait for I/O
+     */
+    bool isRunnable(int index) const {
+        return !(flags[index] & (DONE | BLOCKED));
+    }
+
+    /**
+     * @param index The index of a process
+     * @return The amount of time the process still needs to run
+     */
+    int remainingTime(int index) const {
+        return totalTimeNeeded[index] - timeScheduled[index];
+    }
+
+    /**
+     * Record that a process has arrived at the CPU
+     * @param index The index of the process
+     */
+    void markArrived(int index) {
+        flags[index] |= ARRIVED;
+    }
+
+    /**
+     * Record that a process has finished computing
+     * @param index The index of the process
+     * @param time The time the process finished
+     */
+    void markDone(int index, int time) {
+        flags[index] |= DONE;
+        timeFinished[index] = time;
+    }
+
+    /**
+     * Record that a process has left the CPU to wait for I/O
+     * @param index The index of the process
+     */
+    void markBlocked(int index) {
+        flags[index] |= BLOCKED;
+    }
+
+    /**
+     * Record that the I/O a process was waiting for has completed
+     * @param index The index of the process
+     */
+    void markUnblocked(int index) {
+        flags[index] &= ~BLOCKED;
+    }
+
+};
+
+#endif //PROCESS_TABLE_H
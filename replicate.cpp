@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+#include "replicate.h"
+#include "flag_parsing.h"
+#include "parallel.h"
+#include "process_file.h"
+#include "scheduler_dispatch.h"
+#include "simulator.h"
+
+using namespace std;
+
+/**
+ * Source of reproducible random numbers for randomizing a replica
+ * Numbers are drawn with explicit formulas rather than the standard library distributions, whose output differs
+ * between implementations, so a seed randomizes a workload the same way on every platform
+ */
+class ReplicaRandom {
+
+public:
+
+    explicit ReplicaRandom(uint64_t seed) : engine(seed) {}
+
+    /**
+     * @return A uniformly distributed number in the interval [0, 1)
+     */
+    double uniform() {
+        return (engine() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @param low The smallest number
+     * @param high The largest number
+     * @return A uniformly distributed whole number from low to high
+     */
+    int between(int low, int high) {
+        return low + static_cast<int>(uniform() * (static_cast<double>(high) - low + 1));
+    }
+
+private:
+
+    mt19937_64 engine;  // produces the same sequence for a seed on every platform
+
+};
+
+/**
+ * Simulates one scheduler on many randomized copies of a workload at the same time, and prints the mean of
+ * every run statistic with a 95% confidence interval
+ * Each replica jitters the arrival and computation times of the workload with random numbers from its own seed,
+ * derived from the run's seed and the replica's number, and the results are combined in order of replica, so
+ * the output only depends on the seed and not on the number of threads or the order the replicas finish in
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return 0 if the run is successful
+ */
+int runReplications(int argc, char* argv[]) {
+
+    ReplicationOptions options = parseReplicationOptions(argc, argv);
+
+    ProcessTable workload;
+    readProcessFile(options.filename, options.processType, workload);
+
+    vector<Replica> replicas(options.numReplicas);
+    parallelFor(replicas.size(), options.numThreads, [&](unsigned int r) {
+        Replica& replica = replicas[r];
+        replica.seed = replicaSeed(options.seed, r);
+
+        ProcessTable processes = workload;
+        randomizeWorkload(processes, options, replica.seed);
+        vector<Scheduler*> schedulingAlgorithms = createSchedulers(options.processType, options.schedulerType, processes,
+                                                                   options.timeQuantum, options.numCpus,
+                                                                   options.queueMode);
+
+        visitSchedulers(options.processType, options.schedulerType, schedulingAlgorithms, [&](const auto& schedulers) {
+            BasicSimulator simulator(schedulers, processes, options.numCpus, options.queueMode);
+            while(!simulator.isComplete()) {
+                simulator.step();
+            }
+            const LatencyMetrics& latency = simulator.getMetrics().forType(options.processType);
+            replica.statistics = computeStatistics(processes, options.processType, simulator);
+            replica.meanWaitingTime = latency.waitingTime.mean();
+            replica.p99TurnaroundTime = latency.turnaroundTime.quantile(0.99);
+        });
+        for(Scheduler* schedulingAlgorithm : schedulingAlgorithms) {
+            delete schedulingAlgorithm;
+        }
+    });
+
+    // Gather each metric in order of replica
+    vector<double> finishTimes, idlePercentages, turnaroundTimes, normalizedTurnaroundTimes, waitingTimes,
+                   p99TurnaroundTimes, metDeadlinesPercentages;
+    for(const Replica& replica : replicas) {
+        finishTimes.push_back(replica.statistics.finishTime);
+        idlePercentages.push_back(replica.statistics.idlePercentage);
+        turnaroundTimes.push_back(replica.statistics.meanTurnaroundTime);
+        normalizedTurnaroundTimes.push_back(replica.statistics.meanNormalizedTurnaroundTime);
+        waitingTimes.push_back(replica.meanWaitingTime);
+        p99TurnaroundTimes.push_back(replica.p99TurnaroundTime);
+        metDeadlinesPercentages.push_back(replica.statistics.metDeadlinesPercentage);
+    }
+    bool isRealtime = options.processType == REALTIME;
+
+    cout << setprecision(6) << fixed;
+    cout << "{" << endl;
+    cout << "  \"file\": \"" << jsonEscape(options.filename) << "\"," << endl;
+    cout << "  \"processType\": \"" << processTypeName(options.processType) << "\"," << endl;
+    cout << "  \"scheduler\": \"" << schedulerNames(options.processType).at(options.schedulerType - 1) << "\"," << endl;
+    cout << "  \"timeQuantum\": " << options.timeQuantum << "," << endl;
+    cout << "  \"numCpus\": " << options.numCpus << "," << endl;
+    cout << "  \"queues\": \"" << queueModeName(options.queueMode) << "\"," << endl;
+    cout << "  \"numProcesses\": " << workload.size() << "," << endl;
+    cout << "  \"replicas\": " << options.numReplicas << "," << endl;
+    cout << "  \"seed\": " << options.seed << "," << endl;
+    cout << "  \"arrivalJitter\": " << options.arrivalJitter << "," << endl;
+    cout << "  \"burstJitter\": " << options.burstJitter << "," << endl;
+    cout << "  \"confidence\": 0.95," << endl;
+    cout << "  \"metrics\": {" << endl;
+    outputReplicatedMetric(cout, "finishTime", finishTimes);
+    outputReplicatedMetric(cout, "idlePercentage", idlePercentages);
+    outputReplicatedMetric(cout, "meanTurnaroundTime", turnaroundTimes);
+    outputReplicatedMetric(cout, "meanNormalizedTurnaroundTime", normalizedTurnaroundTimes);
+    outputReplicatedMetric(cout, "meanWaitingTime", waitingTimes);
+    outputReplicatedMetric(cout, "p99TurnaroundTime", p99TurnaroundTimes, !isRealtime);
+    if(isRealtime) {
+        outputReplicatedMetric(cout, "metDeadlinesPercentage", metDeadlinesPercentages, true);
+    }
+    cout << "  }," << endl;
+
+    cout << "  \"runs\": [";
+    for(unsigned int r = 0; r < replicas.size(); r++) {
+        const Replica& replica = replicas[r];
+        cout << (r == 0 ? "" : ",") << "\n    {"
+             << "\"replica\": " << r << ", "
+             << "\"seed\": " << replica.seed << ", "
+             << "\"finishTime\": " << replica.statistics.finishTime << ", "
+             << "\"meanTurnaroundTime\": " << replica.statistics.meanTurnaroundTime << ", "
+             << "\"meanNormalizedTurnaroundTime\": " << replica.statistics.meanNormalizedTurnaroundTime;
+        if(isRealtime) {
+            cout << ", \"metDeadlinesPercentage\": " << replica.statistics.metDeadlinesPercentage;
+        }
+        cout << "}";
+    }
+    cout << "\n  ]" << endl;
+    cout << "}" << endl;
+
+    return 0;
+}
+
+/**
+ * Print how to run the program in replication mode
+ * @param out The stream to write the usage to
+ */
+void outputReplicationUsage(ostream& out) {
+    out << "Usage: program --replicate K --scheduler SCHEDULER [options] process_file" << endl;
+    out << "  --replicate K          number of randomized copies of the workload to simulate (at least 2)" << endl;
+    out << "  --type TYPE            batch, interactive, or realtime (default: detect from the file)" << endl;
+    out << "  --scheduler SCHEDULER  batch: fifo, spn, srt, hrrn" << endl;
+    out << "                         interactive: rr, ml, mlf, fifo" << endl;
+    out << "                         realtime: rm, edf, fifo" << endl;
+    out << "  --seed N               seed every replica's random numbers are derived from (default 1)" << endl;
+    out << "  --arrival-jitter N     move each arrival time by up to N time steps either way (default 5)" << endl;
+    out << "  --burst-jitter F       scale each computation time by up to the fraction F either way (default 0.1)" << endl;
+    out << "  --threads N            number of replicas to simulate at once (default " << defaultThreadCount() << ")" << endl;
+    out << "  --quantum N            time quantum for rr and ml, and for the top level of mlf (default 10)" << endl;
+    out << "  --cpus N               number of CPUs to simulate (default 1)" << endl;
+    out << "  --queues MODE          global (default) or per-cpu run queues with work stealing" << endl;
+}
+
+/**
+ * Read the flags for a replication run, terminating the program if any are missing or invalid
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return The options for the run
+ */
+ReplicationOptions parseReplicationOptions(int argc, char* argv[]) {
+
+    ReplicationOptions options;
+    options.numThreads = defaultThreadCount();
+    string schedulerName;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--help") {
+            outputReplicationUsage(cout);
+            exit(0);
+        } else if(argument.rfind("--", 0) != 0) {
+            if(!options.filename.empty()) {
+                cerr << "Unexpected argument \"" << argument << "\"" << endl;
+                outputReplicationUsage(cerr);
+                exit(-1);
+            }
+            options.filename = argument;
+            continue;
+        }
+
+        // every remaining flag takes a value
+        if(i + 1 >= argc) {
+            cerr << "Missing value for " << argument << endl;
+            outputReplicationUsage(cerr);
+            exit(-1);
+        }
+        string value = argv[++i];
+
+        if(argument == "--replicate") {
+            options.numReplicas = parseIntegerFlag(argument, value);
+            if(options.numReplicas < 2) {
+                cerr << "A confidence interval needs at least 2 replicas" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--type") {
+            options.processType = processTypeFromName(value);
+            if(options.processType == NONE) {
+                cerr << "Invalid process type \"" << value << "\"" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--scheduler") {
+            schedulerName = value;
+        } else if(argument == "--seed") {
+            options.seed = parseUnsignedFlag(argument, value);
+        } else if(argument == "--arrival-jitter") {
+            options.arrivalJitter = parseIntegerFlag(argument, value);
+            if(options.arrivalJitter < 0) {
+                cerr << "The arrival jitter cannot be negative" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--burst-jitter") {
+            options.burstJitter = parseDecimalFlag(argument, value);
+            if(!(options.burstJitter >= 0 && options.burstJitter < 1)) {  // also rejects nan
+                cerr << "The burst jitter must be at least 0 and less than 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--threads") {
+            options.numThreads = max(1, parseIntegerFlag(argument, value));
+        } else if(argument == "--quantum") {
+            options.timeQuantum = parseIntegerFlag(argument, value);
+            if(options.timeQuantum < 1) {
+                cerr << "The time quantum must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--cpus") {
+            options.numCpus = parseIntegerFlag(argument, value);
+            if(options.numCpus < 1) {
+                cerr << "The number of CPUs must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--queues") {
+            if(!queueModeFromName(value, options.queueMode)) {
+                cerr << "Invalid queue mode \"" << value << "\"" << endl;
+                exit(-1);
+            }
+        } else {
+            cerr << "Unknown flag " << argument << endl;
+            outputReplicationUsage(cerr);
+            exit(-1);
+        }
+    }
+
+    if(options.filename.empty()) {
+        cerr << "Did not specify process file" << endl;
+        exit(-1);
+    } else if(schedulerName.empty()) {
+        cerr << "Did not specify scheduler" << endl;
+        exit(-1);
+    }
+
+    if(options.processType == NONE) {
+        options.processType = detectProcessType(options.filename);
+    }
+    options.schedulerType = schedulerTypeFromName(options.processType, schedulerName);
+    if(options.schedulerType < 0) {
+        cerr << "Scheduler \"" << schedulerName << "\" is not available for " << processTypeName(options.processType)
+             << " processes" << endl;
+        exit(-1);
+    }
+
+    return options;
+}
+
+/**
+ * Derives the seed of one replica, so that every replica has its own stream of random numbers that does not
+ * depend on which thread simulates it (the SplitMix64 mixing function, applied to the replica's number)
+ * @param seed The seed of the whole run
+ * @param replica The number of the replica, counting from 0
+ * @return The seed of the replica
+ */
+uint64_t replicaSeed(uint64_t seed, unsigned int replica) {
+    uint64_t z = seed + (replica + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Randomizes a copy of the workload: each arrival time moves by a whole number of time steps within the arrival
+ * jitter, without going below 0, and each computation time is scaled by a factor within the burst jitter of 1,
+ * rounded and kept at least 1
+ * A realtime process keeps the same time between its arrival and its deadline
+ * @param processes The processes to randomize, which have not been simulated
+ * @param options The options for the run
+ * @param seed The seed of the replica
+ */
+void randomizeWorkload(ProcessTable& processes, const ReplicationOptions& options, uint64_t seed) {
+
+    ReplicaRandom random(seed);
+    for(unsigned int i = 0; i < processes.size(); i++) {
+        int arrivalTime = max(0, processes.arrivalTime[i] + random.between(-options.arrivalJitter, options.arrivalJitter));
+        double scale = 1 + options.burstJitter * (2 * random.uniform() - 1);
+        int computationTime = max(1, static_cast<int>(lround(processes.totalTimeNeeded[i] * scale)));
+
+        if(processes.processType == REALTIME) {
+            processes.deadline[i] += arrivalTime - processes.arrivalTime[i];
+        }
+        processes.arrivalTime[i] = arrivalTime;
+        processes.totalTimeNeeded[i] = computationTime;
+    }
+}
+
+/**
+ * @param degreesOfFreedom The degrees of freedom of a Student's t distribution, at least 1
+ * @return The value the distribution is below with probability 0.975, for a two-sided 95% confidence interval
+ */
+double studentT95(int degreesOfFreedom) {
+
+    static const double TABLE[] = {12.706205, 4.302653, 3.182446, 2.776445, 2.570582, 2.446912, 2.364624, 2.306004,
+                                   2.262157, 2.228139, 2.200985, 2.178813, 2.160369, 2.144787, 2.131450, 2.119905,
+                                   2.109816, 2.100922, 2.093024, 2.085963, 2.079614, 2.073873, 2.068658, 2.063899,
+                                   2.059539, 2.055529, 2.051831, 2.048407, 2.045230, 2.042272};
+    const int TABLE_SIZE = sizeof(TABLE) / sizeof(TABLE[0]);
+
+    if(degreesOfFreedom <= TABLE_SIZE) {
+        return TABLE[degreesOfFreedom - 1];
+    }
+
+    // beyond the table, the Cornish-Fisher expansion around the normal quantile is accurate to about 6 decimal places
+    double z = 1.959964;
+    double v = degreesOfFreedom;
+    return z + (z * z * z + z) / (4 * v)
+             + (5 * pow(z, 5) + 16 * z * z * z + 3 * z) / (96 * v * v)
+             + (3 * pow(z, 7) + 19 * pow(z, 5) + 17 * z * z * z - 15 * z) / (384 * v * v * v);
+}
+
+/**
+ * @param values The value of a metric in every replica, in order of replica
+ * @return The mean of the values with its 95% confidence interval, from Student's t distribution
+ */
+ReplicatedMetric replicateMetric(const vector<double>& values) {
+
+    ReplicatedMetric metric;
+    double sum = 0;
+    for(double value : values) {
+        sum += value;
+    }
+    metric.mean = sum / values.size();
+
+    double squaredDeviations = 0;
+    for(double value : values) {
+        squaredDeviations += (value - metric.mean) * (value - metric.mean);
+    }
+    metric.standardDeviation = sqrt(squaredDeviations / (values.size() - 1));
+
+    double halfWidth = studentT95(values.size() - 1) * metric.standardDeviation / sqrt(values.size());
+    metric.low = metric.mean - halfWidth;
+    metric.high = metric.mean + halfWidth;
+    return metric;
+}
+
+/**
+ * Print one metric of a replication run as a member of the JSON "metrics" object
+ * @param out The stream to write the metric to
+ * @param name The name of the metric
+ * @param values The value of the metric in every replica, in order of replica
+ * @param last Whether this is the last member of the object
+ */
+void outputReplicatedMetric(ostream& out, const string& name, const vector<double>& values, bool last) {
+    ReplicatedMetric metric = replicateMetric(values);
+    out << "    \"" << name << "\": {"
+        << "\"mean\": " << metric.mean << ", "
+        << "\"standardDeviation\": " << metric.standardDeviation << ", "
+        << "\"low\": " << metric.low << ", "
+        << "\"high\": " << metric.high << "}" << (last ? "" : ",") << endl;
+}
@@ -0,0 +1,60 @@
+#ifndef REPLICATE_H
+#define REPLICATE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "main.h"
+#include "process_table.h"
+
+using namespace std;
+
+/**
+ * Options for a replication run, taken from command-line flags
+ */
+struct ReplicationOptions {
+    string filename;  // the file containing the list of processes to randomize
+    ProcessType processType = NONE;  // the type of processes in the file, or NONE to detect it
+    int schedulerType = -1;  // the number of the scheduling algorithm, as listed by promptForSchedulingAlgorithm
+    int timeQuantum = 10;  // the time quantum for the Round Robin based algorithms
+    int numCpus = 1;  // the number of CPUs to simulate
+    QueueMode queueMode = GLOBAL_QUEUE;  // how the CPUs share the processes that are ready to run
+    int numReplicas = 0;  // the number of randomized copies of the workload to simulate
+    uint64_t seed = 1;  // the seed every replica's random numbers are derived from
+    int arrivalJitter = 5;  // arrival times move by up to this many time steps either way
+    double burstJitter = 0.1;  // computation times are scaled by up to this fraction either way
+    unsigned int numThreads = 1;  // the number of replicas to simulate at once
+};
+
+/**
+ * Data structure for one randomized copy of the workload and the results of simulating it
+ */
+struct Replica {
+    uint64_t seed = 0;  // the seed of the replica's random numbers
+    RunStatistics statistics;  // the results of the simulation
+    double meanWaitingTime = 0;  // the mean time processes spent ready but not running
+    double p99TurnaroundTime = 0;  // the 99th percentile of the turnaround time
+};
+
+/**
+ * Data structure for the spread of one metric over every replica
+ */
+struct ReplicatedMetric {
+    double mean = 0;  // the mean over the replicas
+    double standardDeviation = 0;  // the sample standard deviation over the replicas
+    double low = 0;  // the lower end of the 95% confidence interval for the mean
+    double high = 0;  // the upper end of the 95% confidence interval for the mean
+};
+
+int runReplications(int argc, char* argv[]);
+void outputReplicationUsage(ostream& out);
+ReplicationOptions parseReplicationOptions(int argc, char* argv[]);
+uint64_t replicaSeed(uint64_t seed, unsigned int replica);
+void randomizeWorkload(ProcessTable& processes, const ReplicationOptions& options, uint64_t seed);
+double studentT95(int degreesOfFreedom);
+ReplicatedMetric replicateMetric(const vector<double>& values);
+void outputReplicatedMetric(ostream& out, const string& name, const vector<double>& values, bool last = false);
+
+#endif //REPLICATE_H
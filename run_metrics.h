@@ -0,0 +1,119 @@
+#ifndef RUN_METRICS_H
+#define RUN_METRICS_H
+
+#include <algorithm>
+
+#include "log_histogram.h"
+#include "process.h"
+#include "process_table.h"
+
+using namespace std;
+
+const int METRICS_PRIORITY_LEVELS = 5;  // interactive priorities are grouped from 1 to 5, as in Multilevel
+const int NORMALIZED_TURNAROUND_SCALE = 1000;  // normalized turnaround times are counted in thousandths
+
+/**
+ * Distributions of the per-process metrics of one group of processes
+ * The turnaround time is the time from arriving to finishing, the normalized turnaround time is the turnaround
+ * time relative to the computation time, the waiting time is the time spent ready to run but not running, and the
+ * response time is the time from arriving to first running
+ */
+struct LatencyMetrics {
+    LogHistogram turnaroundTime;  // finish time minus arrival time
+    LogHistogram normalizedTurnaroundTime;  // turnaround time over computation time, in NORMALIZED_TURNAROUND_SCALE units
+    LogHistogram waitingTime;  // time steps between arriving and finishing when the process was ready but not running
+    LogHistogram responseTime;  // time steps between arriving and first running
+};
+
+/**
+ * Streaming statistics of a simulation, recorded as processes first run and as they finish
+ * Metrics are kept per process type and, for interactive processes, per priority level, in histograms whose
+ * size does not depend on the number of processes
+ */
+class RunMetrics {
+
+public:
+
+    /**
+     * Records the response time of a process that is running for the first time
+     * @param processes The table of processes
+     * @param index The index of the process
+     * @param time The time step the process starts running
+     */
+    void recordFirstRun(const ProcessTable& processes, int index, int time) {
+        long long responseTime = time - processes.arrivalTime[index];
+        forProcess(processes, index, BY_TYPE).responseTime.record(responseTime);
+        if(processes.processType == INTERACTIVE) {
+            forProcess(processes, index, BY_PRIORITY).responseTime.record(responseTime);
+        }
+    }
+
+    /**
+     * Records the turnaround, normalized turnaround, and waiting times of a process that has just finished
+     * @param processes The table of processes
+     * @param index The index of the process
+     * @param timeBlocked The time the process spent blocked on I/O, which is not waiting for a CPU
+     */
+    void recordFinish(const ProcessTable& processes, int index, int timeBlocked = 0) {
+        long long turnaroundTime = processes.timeFinished[index] - processes.arrivalTime[index];
+        long long computationTime = processes.totalTimeNeeded[index];
+        long long normalizedTurnaroundTime = computationTime > 0
+                ? (turnaroundTime * NORMALIZED_TURNAROUND_SCALE + computationTime / 2) / computationTime : 0;
+        long long waitingTime = turnaroundTime + 1 - computationTime - timeBlocked;  // it runs through its finish time
+
+        record(forProcess(processes, index, BY_TYPE), turnaroundTime, normalizedTurnaroundTime, waitingTime);
+        if(processes.processType == INTERACTIVE) {
+            record(forProcess(processes, index, BY_PRIORITY), turnaroundTime, normalizedTurnaroundTime, waitingTime);
+        }
+    }
+
+    /**
+     * @param processType A process type
+     * @return The metrics of every process of that type
+     */
+    const LatencyMetrics& forType(ProcessType processType) const {
+        return byType[processType];
+    }
+
+    /**
+     * @param priority An interactive priority level, from 1 to METRICS_PRIORITY_LEVELS
+     * @return The metrics of every interactive process at that priority
+     */
+    const LatencyMetrics& forPriority(int priority) const {
+        return byPriority[priority];
+    }
+
+private:
+
+    static const int BY_TYPE = 0;  // grouping of processes by type
+    static const int BY_PRIORITY = 1;  // grouping of interactive processes by priority
+
+    LatencyMetrics byType[REALTIME + 1];  // metrics of each process type
+    LatencyMetrics byPriority[METRICS_PRIORITY_LEVELS + 1];  // metrics of each interactive priority (no level 0)
+
+    /**
+     * @param processes The table of processes
+     * @param index The index of a process
+     * @param grouping BY_TYPE or BY_PRIORITY
+     * @return The metrics of the process's group
+     */
+    LatencyMetrics& forProcess(const ProcessTable& processes, int index, int grouping) {
+        if(grouping == BY_PRIORITY) {
+            return byPriority[min(max(processes.priority[index], 1), METRICS_PRIORITY_LEVELS)];
+        }
+        return byType[processes.processType];
+    }
+
+    /**
+     * Records the metrics of a finished process in a group
+     */
+    static void record(LatencyMetrics& metrics, long long turnaroundTime, long long normalizedTurnaroundTime,
+                       long long waitingTime) {
+        metrics.turnaroundTime.record(turnaroundTime);
+        metrics.normalizedTurnaroundTime.record(normalizedTurnaroundTime);
+        metrics.waitingTime.record(waitingTime);
+    }
+
+};
+
+#endif //RUN_METRICS_H
@@ -0,0 +1,602 @@
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#include "sched_trace.h"
+
+using namespace std;
+
+const size_t TRACE_READ_SIZE = 1 << 20;  // traces are read 1 MiB at a time, whatever their size
+const size_t TRACE_DETECT_SIZE = 1 << 16;  // how much of the start of a file is searched for scheduler events
+const int TRACE_HEADER_WIDTH = 20;  // the width of the process count written at the start of a converted trace
+
+/**
+ * Kinds of scheduler events read from a trace
+ */
+enum TraceEventKind {
+    SWITCH_EVENT,  // sched_switch: a CPU stops running one task and starts running another
+    WAKEUP_EVENT  // sched_wakeup or sched_wakeup_new: a task becomes runnable
+};
+
+/**
+ * Data structure for the fields of a scheduler event that the importer uses
+ * For a wakeup, the woken task is described by the next* fields
+ */
+struct TraceEvent {
+    TraceEventKind kind = SWITCH_EVENT;  // the kind of event
+    long long time = 0;  // the timestamp, in nanoseconds
+    string_view prevComm;  // the command name of the task leaving the CPU
+    long long prevPid = 0;  // the pid of the task leaving the CPU
+    long long prevPriority = 0;  // the kernel priority of the task leaving the CPU
+    bool prevRunnable = false;  // whether the task leaving the CPU was preempted rather than going to sleep
+    string_view nextComm;  // the command name of the task starting to run, or of the woken task
+    long long nextPid = 0;  // the pid of the task starting to run, or of the woken task
+    long long nextPriority = 0;  // the kernel priority of the task starting to run, or of the woken task
+};
+
+/**
+ * Data structure for what the importer knows about one thread while it reads the trace
+ */
+struct TraceThread {
+    unsigned int index = 0;  // the thread's number, in the order threads first appear
+    string id;  // the command name and pid, with spaces replaced so that it is a single field
+    int priority = 1;  // the interactive priority from the thread's latest kernel priority
+    long long burstStart = -1;  // when the thread became runnable, or -1 if it is asleep
+    long long runningSince = -1;  // when the thread was switched in, or -1 if it is not on a CPU
+    long long cpuTime = 0;  // the nanoseconds the thread has run for in its current burst
+};
+
+/**
+ * Calls a function with every line of a file, reading the file in blocks so that memory use does not grow with
+ * its size, and terminating the program if it cannot be read
+ * @param filename The name of the file
+ * @param process Called with each line, without its line ending
+ * @return The number of lines
+ */
+static long long forEachLine(const string& filename, const function<void(string_view)>& process) {
+
+    ifstream in(filename.c_str(), ios::binary);
+    if(in.fail()) {
+        cerr << "Unable to open file \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    vector<char> buffer(TRACE_READ_SIZE);
+    string partial;  // the start of a line that continues in the next block
+    long long numLines = 0;
+
+    while(in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+        const char* position = buffer.data();
+        const char* end = position + in.gcount();
+        while(position != end) {
+            const char* newline = find(position, end, '\n');
+            if(newline == end) {
+                partial.append(position, end);
+                break;
+            }
+            string_view line(position, newline - position);
+            if(!partial.empty()) {
+                partial.append(position, newline);
+                line = partial;
+            }
+            if(!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+            process(line);
+            numLines++;
+            partial.clear();
+            position = newline + 1;
+        }
+    }
+    if(in.bad()) {
+        cerr << "Failed to read \"" << filename << "\"" << endl;
+        exit(-1);
+    }
+
+    if(!partial.empty()) {
+        process(partial);
+        numLines++;
+    }
+    return numLines;
+}
+
+/**
+ * Parses an integer at the start of some text
+ * @param text The text, which is advanced past the integer
+ * @param value Set to the integer
+ * @return Whether the text started with an integer
+ */
+static bool parseLong(string_view& text, long long& value) {
+    bool negative = !text.empty() && text.front() == '-';
+    size_t position = negative ? 1 : 0;
+    if(position == text.size() || text[position] < '0' || text[position] > '9') {
+        return false;
+    }
+    value = 0;
+    while(position < text.size() && text[position] >= '0' && text[position] <= '9') {
+        value = value * 10 + (text[position] - '0');
+        position++;
+    }
+    if(negative) {
+        value = -value;
+    }
+    text.remove_prefix(position);
+    return true;
+}
+
+/**
+ * Finds the scheduler event in a line of a trace, written as "sched_switch:" by ftrace and trace-cmd, and as
+ * "sched:sched_switch:" by perf
+ * @param line The line
+ * @param kind Set to the kind of event
+ * @param nameStart Set to where the event name starts in the line
+ * @param body Set to the fields of the event, after its name
+ * @return Whether the line holds a sched_switch or sched_wakeup event
+ */
+static bool findEvent(string_view line, TraceEventKind& kind, size_t& nameStart, string_view& body) {
+
+    static const struct {
+        string_view name;
+        TraceEventKind kind;
+    } names[] = {{"sched_switch:", SWITCH_EVENT}, {"sched_wakeup:", WAKEUP_EVENT}, {"sched_wakeup_new:", WAKEUP_EVENT}};
+
+    for(size_t position = line.find("sched_"); position != string_view::npos; position = line.find("sched_", position + 1)) {
+        if(position > 0 && line[position - 1] != ' ' && line[position - 1] != ':') {
+            continue;
+        }
+        for(const auto& name : names) {
+            if(line.compare(position, name.name.size(), name.name) == 0) {
+                kind = name.kind;
+                nameStart = position;
+                body = line.substr(position + name.name.size());
+                while(!body.empty() && body.front() == ' ') {
+                    body.remove_prefix(1);
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Reads the timestamp in front of an event name: seconds with a fraction, followed by a colon
+ * @param line The line
+ * @param nameStart Where the event name starts in the line
+ * @param nanoseconds Set to the timestamp in nanoseconds
+ * @return Whether the timestamp could be read
+ */
+static bool parseTimestamp(string_view line, size_t nameStart, long long& nanoseconds) {
+
+    size_t end = nameStart;
+    if(end >= 6 && line.compare(end - 6, 6, "sched:") == 0) {
+        end -= 6;  // perf names the event with its subsystem
+    }
+    while(end > 0 && line[end - 1] == ' ') {
+        end--;
+    }
+    if(end == 0 || line[end - 1] != ':') {
+        return false;
+    }
+    end--;
+    size_t start = end;
+    while(start > 0 && ((line[start - 1] >= '0' && line[start - 1] <= '9') || line[start - 1] == '.')) {
+        start--;
+    }
+
+    string_view text = line.substr(start, end - start);
+    long long seconds = 0;
+    if(!parseLong(text, seconds) || seconds < 0) {
+        return false;
+    }
+    long long fraction = 0;
+    int digits = 0;
+    if(!text.empty() && text.front() == '.') {
+        for(text.remove_prefix(1); !text.empty(); text.remove_prefix(1)) {
+            if(digits < 9) {
+                fraction = fraction * 10 + (text.front() - '0');
+                digits++;
+            }
+        }
+    }
+    for(; digits < 9; digits++) {
+        fraction *= 10;
+    }
+    nanoseconds = seconds * 1000000000LL + fraction;
+    return true;
+}
+
+/**
+ * Finds the value of a field written as key=value
+ * @param body The fields of an event
+ * @param key The key, including the "=" and, for every key but the first, the space in front of it
+ * @param nextKey The key that follows, for values that can contain spaces (command names), or empty
+ * @param value Set to the value
+ * @return Whether the field was found
+ */
+static bool fieldValue(string_view body, string_view key, string_view nextKey, string_view& value) {
+    size_t start = body.find(key);
+    if(start == string_view::npos) {
+        return false;
+    }
+    start += key.size();
+    size_t end = nextKey.empty() ? body.find(' ', start) : body.find(nextKey, start);
+    if(!nextKey.empty() && end == string_view::npos) {
+        return false;
+    }
+    value = body.substr(start, end == string_view::npos ? string_view::npos : end - start);
+    return true;
+}
+
+/**
+ * Finds the integer value of a field written as key=value
+ * @param body The fields of an event
+ * @param key The key, including the "=" and the space in front of it
+ * @param value Set to the value
+ * @return Whether the field was found and is an integer
+ */
+static bool integerField(string_view body, string_view key, long long& value) {
+    string_view text;
+    return fieldValue(body, key, "", text) && parseLong(text, value);
+}
+
+/**
+ * Reads a task written the way perf and trace-cmd write it: "comm:pid [prio]"
+ * @param text The text, which is advanced past the task
+ * @param comm Set to the command name, which can itself contain colons
+ * @param pid Set to the pid
+ * @param priority Set to the kernel priority
+ * @return Whether the task could be read
+ */
+static bool parseCompactTask(string_view& text, string_view& comm, long long& pid, long long& priority) {
+    size_t bracket = text.find(" [");
+    if(bracket == string_view::npos) {
+        return false;
+    }
+    size_t colon = text.substr(0, bracket).rfind(':');
+    if(colon == string_view::npos) {
+        return false;
+    }
+    comm = text.substr(0, colon);
+    string_view pidText = text.substr(colon + 1, bracket - colon - 1);
+    string_view priorityText = text.substr(bracket + 2);
+    if(!parseLong(pidText, pid) || !pidText.empty() || !parseLong(priorityText, priority)
+            || priorityText.empty() || priorityText.front() != ']') {
+        return false;
+    }
+    text = priorityText.substr(1);
+    while(!text.empty() && text.front() == ' ') {
+        text.remove_prefix(1);
+    }
+    return true;
+}
+
+/**
+ * Reads the fields of a scheduler event, in either the key=value form of ftrace and older perf versions or the
+ * compact form of newer perf versions and trace-cmd
+ * @param body The fields of the event
+ * @param event The event, whose kind is already set, to fill in
+ * @return Whether every field the importer uses could be read
+ */
+static bool parseEventFields(string_view body, TraceEvent& event) {
+
+    if(event.kind == WAKEUP_EVENT) {
+        if(body.compare(0, 5, "comm=") == 0) {
+            return fieldValue(body, "comm=", " pid=", event.nextComm) && integerField(body, " pid=", event.nextPid)
+                   && integerField(body, " prio=", event.nextPriority);
+        }
+        return parseCompactTask(body, event.nextComm, event.nextPid, event.nextPriority);
+    }
+
+    string_view state;
+    if(body.compare(0, 10, "prev_comm=") == 0) {
+        if(!fieldValue(body, "prev_comm=", " prev_pid=", event.prevComm) || !integerField(body, " prev_pid=", event.prevPid)
+                || !integerField(body, " prev_prio=", event.prevPriority) || !fieldValue(body, " prev_state=", "", state)
+                || !fieldValue(body, " next_comm=", " next_pid=", event.nextComm)
+                || !integerField(body, " next_pid=", event.nextPid) || !integerField(body, " next_prio=", event.nextPriority)) {
+            return false;
+        }
+    } else {
+        size_t arrow = body.find(" ==> ");
+        if(arrow == string_view::npos) {
+            return false;
+        }
+        string_view prev = body.substr(0, arrow);
+        string_view next = body.substr(arrow + 5);
+        if(!parseCompactTask(prev, event.prevComm, event.prevPid, event.prevPriority)
+                || !parseCompactTask(next, event.nextComm, event.nextPid, event.nextPriority)) {
+            return false;
+        }
+        state = prev;
+    }
+
+    // R, or R+ on newer kernels, means the task was preempted and is still runnable
+    event.prevRunnable = !state.empty() && state.front() == 'R';
+    return true;
+}
+
+/**
+ * Checks whether the start of a file holds a scheduler trace rather than a text process file: whether, before
+ * any line that is just a number, a line holds a sched_switch or sched_wakeup event
+ * @param begin The first character of the start of the file
+ * @param end One past the last character of the start of the file
+ * @return Whether the file is a scheduler trace
+ */
+bool isSchedTrace(const char* begin, const char* end) {
+
+    end = begin + min<size_t>(end - begin, TRACE_DETECT_SIZE);
+    for(const char* position = begin; position < end;) {
+        const char* newline = find(position, end, '\n');
+        string_view line(position, newline - position);
+        position = newline + 1;
+
+        size_t first = line.find_first_not_of(" \t\r");
+        if(first == string_view::npos || line[first] == '#') {
+            continue;  // blank lines and the comments at the start of an ftrace dump
+        }
+
+        TraceEventKind kind;
+        size_t nameStart;
+        string_view body;
+        if(findEvent(line, kind, nameStart, body)) {
+            return true;
+        }
+        string_view rest = line.substr(first);
+        long long number;
+        if(parseLong(rest, number) && rest.find_first_not_of(" \t\r") == string_view::npos) {
+            return false;  // the process count at the start of a process file
+        }
+    }
+    return false;
+}
+
+/**
+ * Checks whether a file holds a scheduler trace rather than a process file, from its first bytes
+ * @param filename The name of the file
+ * @return Whether the file is a scheduler trace
+ */
+bool isSchedTraceFile(const string& filename) {
+    ifstream in(filename.c_str(), ios::binary);
+    vector<char> start(TRACE_DETECT_SIZE);
+    in.read(start.data(), start.size());
+    return isSchedTrace(start.data(), start.data() + in.gcount());
+}
+
+/**
+ * Maps a kernel priority to an interactive priority level
+ * Normal tasks have kernel priorities from 100 (nice -20) to 139 (nice 19), which are split evenly over the
+ * five levels, so nice 0 is level 3; realtime and deadline tasks (below 100) get the highest level
+ * @param kernelPriority The priority the kernel reports for a task
+ * @return The priority, from 1 (lowest) to 5 (highest)
+ */
+int priorityFromKernelPriority(int kernelPriority) {
+    if(kernelPriority < 100) {
+        return 5;
+    }
+    int nice = min(max(kernelPriority - 120, -20), 19);
+    return 5 - (nice + 20) / 8;
+}
+
+/**
+ * Reads a scheduler trace in one pass and reports every CPU burst of every thread as it ends
+ * A burst starts when a thread is woken (or, for threads already running when the trace starts, at its first
+ * event), adds up the time the thread spends on a CPU, continues through preemptions, and ends when the thread
+ * is switched out to sleep; bursts still going at the end of the trace end with it
+ * Only the threads are kept in memory, so traces of any length are read in memory that grows with the number
+ * of threads, not with the number of events
+ * Times are counted in time steps of the given length from the first event, with computation times rounded up,
+ * and the program terminates if a time does not fit in an int
+ * @param filename The trace, a text dump of sched_switch and sched_wakeup events from perf sched script,
+ *                 ftrace, or trace-cmd report
+ * @param options The options for the conversion
+ * @param emit Called with each burst as it ends
+ * @return Counts of what was read
+ */
+TraceSummary readSchedTrace(const string& filename, const TraceOptions& options, const function<void(const TraceJob&)>& emit) {
+
+    if(options.tickNanoseconds < 1) {
+        cerr << "The time step of a trace must be at least 1 nanosecond" << endl;
+        exit(-1);
+    }
+
+    TraceSummary summary;
+    unordered_map<long long, TraceThread> threads;
+    long long firstTime = -1;
+    long long lastTime = 0;
+    TraceEvent event;
+
+    // the thread for a pid, which is added the first time it appears
+    auto threadFor = [&](long long pid, string_view comm, long long kernelPriority) -> TraceThread& {
+        auto [iterator, added] = threads.try_emplace(pid);
+        TraceThread& thread = iterator->second;
+        if(added) {
+            thread.index = summary.numThreads++;
+            thread.id.assign(comm.data(), comm.size());
+            replace(thread.id.begin(), thread.id.end(), ' ', '_');
+            thread.id += "-" + to_string(pid);
+        }
+        thread.priority = priorityFromKernelPriority(static_cast<int>(kernelPriority));
+        return thread;
+    };
+
+    // reports the current burst of a thread, if it ran at all, and puts the thread to sleep
+    auto endBurst = [&](TraceThread& thread) {
+        if(thread.cpuTime > 0) {
+            long long arrivalTime = (thread.burstStart - firstTime) / options.tickNanoseconds;
+            long long computationTime = (thread.cpuTime + options.tickNanoseconds - 1) / options.tickNanoseconds;
+            if(arrivalTime > INT_MAX || computationTime > INT_MAX) {
+                cerr << "\"" << filename << "\" is too long to count in time steps of " << options.tickNanoseconds
+                     << " ns; use longer time steps" << endl;
+                exit(-1);
+            }
+            emit(TraceJob{thread.index, thread.id, static_cast<int>(arrivalTime), static_cast<int>(computationTime),
+                          thread.priority});
+            summary.numJobs++;
+        }
+        thread.burstStart = -1;
+        thread.cpuTime = 0;
+    };
+
+    summary.numLines = forEachLine(filename, [&](string_view line) {
+
+        size_t nameStart;
+        string_view body;
+        if(!findEvent(line, event.kind, nameStart, body)) {
+            return;  // other events, headers, and comments
+        }
+        if(!parseTimestamp(line, nameStart, event.time) || !parseEventFields(body, event)) {
+            summary.numMalformed++;
+            return;
+        }
+        summary.numEvents++;
+        if(firstTime < 0) {
+            firstTime = event.time;
+        }
+        event.time = max(event.time, lastTime);  // events from different CPUs can be a little out of order
+        lastTime = event.time;
+
+        // pid 0 is the idle task of each CPU, which is not simulated
+        if(event.kind == WAKEUP_EVENT) {
+            if(event.nextPid != 0) {
+                TraceThread& thread = threadFor(event.nextPid, event.nextComm, event.nextPriority);
+                if(thread.burstStart < 0) {
+                    thread.burstStart = event.time;
+                }
+            }
+            return;
+        }
+
+        if(event.prevPid != 0) {
+            TraceThread& thread = threadFor(event.prevPid, event.prevComm, event.prevPriority);
+            if(thread.runningSince < 0) {
+                thread.runningSince = firstTime;  // it was already running when the trace started
+            }
+            if(thread.burstStart < 0) {
+                thread.burstStart = thread.runningSince;
+            }
+            thread.cpuTime += event.time - thread.runningSince;
+            thread.runningSince = -1;
+            if(!event.prevRunnable) {
+                endBurst(thread);
+            }
+        }
+        if(event.nextPid != 0) {
+            TraceThread& thread = threadFor(event.nextPid, event.nextComm, event.nextPriority);
+            if(thread.burstStart < 0) {
+                thread.burstStart = event.time;  // it was already runnable when the trace started
+            }
+            thread.runningSince = event.time;
+        }
+    });
+
+    // The bursts still going when the trace ends are cut off there, in the order the threads appeared
+    vector<TraceThread*> unfinished;
+    for(auto& [pid, thread] : threads) {
+        if(thread.burstStart >= 0) {
+            unfinished.push_back(&thread);
+        }
+    }
+    sort(unfinished.begin(), unfinished.end(), [](const TraceThread* a, const TraceThread* b) {
+        return a->index < b->index;
+    });
+    for(TraceThread* thread : unfinished) {
+        if(thread->runningSince >= 0) {
+            thread->cpuTime += lastTime - thread->runningSince;
+            thread->runningSince = -1;
+        }
+        endBurst(*thread);
+    }
+
+    return summary;
+}
+
+/**
+ * Reads a scheduler trace into a table of processes, one per CPU burst, terminating the program if the trace
+ * has no bursts or the process type cannot hold them
+ * Every burst of a thread shares the thread's id, which is stored once
+ * @param filename The trace
+ * @param processType BATCH, or INTERACTIVE to keep the priorities of the threads
+ * @param processes The table to fill
+ * @param options The options for the conversion
+ */
+void readSchedTraceWorkload(const string& filename, ProcessType processType, ProcessTable& processes,
+                            const TraceOptions& options) {
+
+    if(processType != BATCH && processType != INTERACTIVE) {
+        cerr << "Scheduler traces can only be read as batch or interactive processes" << endl;
+        exit(-1);
+    }
+
+    processes = ProcessTable(processType);
+    vector<unsigned int> threadIds;  // the index in the id table of each thread's id
+    TraceSummary summary = readSchedTrace(filename, options, [&](const TraceJob& job) {
+        if(job.threadIndex >= threadIds.size()) {
+            threadIds.resize(job.threadIndex + 1, UINT_MAX);
+        }
+        if(threadIds[job.threadIndex] == UINT_MAX) {
+            threadIds[job.threadIndex] = processes.ids.add(job.id);
+        }
+        unsigned int index = processes.size();
+        processes.resize(index + 1);
+        processes.idIndex[index] = threadIds[job.threadIndex];
+        processes.arrivalTime[index] = job.arrivalTime;
+        processes.totalTimeNeeded[index] = job.computationTime;
+        if(processType == INTERACTIVE) {
+            processes.priority[index] = job.priority;
+        }
+    });
+
+    if(summary.numJobs == 0) {
+        cerr << "Found no CPU bursts in the scheduler trace \"" << filename << "\", terminating program" << endl;
+        exit(-1);
+    }
+}
+
+/**
+ * Converts a scheduler trace to a text process file in one pass, writing every burst as soon as it ends
+ * The process count is only known at the end, so it is written over a blank header of fixed width
+ * @param filename The trace
+ * @param processType BATCH, or INTERACTIVE to keep the priorities of the threads
+ * @param outputFilename The process file to write
+ * @param options The options for the conversion
+ * @return Counts of what was read
+ */
+TraceSummary convertSchedTrace(const string& filename, ProcessType processType, const string& outputFilename,
+                               const TraceOptions& options) {
+
+    if(processType != BATCH && processType != INTERACTIVE) {
+        cerr << "Scheduler traces can only be converted to batch or interactive processes" << endl;
+        exit(-1);
+    }
+
+    ofstream out;
+    vector<char> buffer(1 << 20);  // large writes keep the output from dominating the run time
+    out.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    out.open(outputFilename.c_str(), ios::binary);
+    if(out.fail()) {
+        cerr << "Unable to open file \"" << outputFilename << "\", terminating program" << endl;
+        exit(-1);
+    }
+
+    out << string(TRACE_HEADER_WIDTH, ' ') << '\n';
+    TraceSummary summary = readSchedTrace(filename, options, [&](const TraceJob& job) {
+        out << job.id << ' ' << job.arrivalTime << ' ' << job.computationTime;
+        if(processType == INTERACTIVE) {
+            out << ' ' << job.priority;
+        }
+        out << '\n';
+    });
+
+    out.seekp(0);
+    out << setw(TRACE_HEADER_WIDTH) << summary.numJobs;
+    out.close();
+    if(out.fail()) {
+        cerr << "Failed to write \"" << outputFilename << "\"" << endl;
+        exit(-1);
+    }
+    return summary;
+}
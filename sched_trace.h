@@ -0,0 +1,54 @@
+#ifndef SCHED_TRACE_H
+#define SCHED_TRACE_H
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "process.h"
+#include "process_table.h"
+
+using namespace std;
+
+const long long DEFAULT_TRACE_TICK_NANOSECONDS = 100000;  // one time step of a trace workload is 100 microseconds
+
+/**
+ * Options for turning a recorded scheduler trace into a workload
+ */
+struct TraceOptions {
+    long long tickNanoseconds = DEFAULT_TRACE_TICK_NANOSECONDS;  // the length of one simulated time step
+};
+
+/**
+ * Data structure for one CPU burst of a traced thread: the time from when it became runnable until it went to
+ * sleep, which the workload simulates as one process
+ */
+struct TraceJob {
+    unsigned int threadIndex = 0;  // the thread the burst belongs to, numbered in the order threads first appear
+    string_view id;  // the id of the thread, its command name and pid, which is only valid during the callback
+    int arrivalTime = 0;  // the time step the thread became runnable, counted from the first event of the trace
+    int computationTime = 0;  // the number of time steps the thread ran for, rounded up
+    int priority = 1;  // the interactive priority of the thread, from 1 (lowest) to 5 (highest)
+};
+
+/**
+ * Counts of what was read from a trace
+ */
+struct TraceSummary {
+    long long numLines = 0;  // the number of lines in the trace
+    long long numEvents = 0;  // the number of sched_switch and sched_wakeup events that were used
+    long long numMalformed = 0;  // the number of scheduler events whose fields could not be read
+    long long numJobs = 0;  // the number of CPU bursts found
+    unsigned int numThreads = 0;  // the number of distinct threads seen, not counting the idle tasks
+};
+
+bool isSchedTrace(const char* begin, const char* end);
+bool isSchedTraceFile(const string& filename);
+TraceSummary readSchedTrace(const string& filename, const TraceOptions& options, const function<void(const TraceJob&)>& emit);
+void readSchedTraceWorkload(const string& filename, ProcessType processType, ProcessTable& processes,
+                            const TraceOptions& options = TraceOptions());
+TraceSummary convertSchedTrace(const string& filename, ProcessType processType, const string& outputFilename,
+                               const TraceOptions& options = TraceOptions());
+int priorityFromKernelPriority(int kernelPriority);
+
+#endif //SCHED_TRACE_H
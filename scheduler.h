@@ -1,11 +1,9 @@
 #ifndef SCHEDULER_H
 #define SCHEDULER_H
 
-#define INFINITY 1000000
-
 #include <vector>
 
-#include "process.h"
+#include "process_table.h"
 
 using namespace std;
 
@@ -18,16 +16,100 @@ public:
 
     explicit Scheduler() {}
 
+    virtual ~Scheduler() {}
+
     /**
      * Pure virtual method for scheduling algorithms to implement
      * Chooses the next process to run by selecting an index from the list of processes
      * This function is executed once per time step
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    virtual int run(int currentProcess, int currentTime, vector<Process*>& processList) = 0;
+    virtual int run(int currentProcess, int currentTime, ProcessTable& processes) = 0;
+
+    /**
+     * Called by the simulator when a process arrives at the CPU, before run() is called for that time step
+     * Lets schedulers keep their own ready sets up to date instead of scanning the list of processes
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes for the scheduler to choose from
+     */
+    virtual void processArrived(int processIndex, ProcessTable& processes) {}
+
+    /**
+     * Lets the simulation skip the time steps during which the process chosen by run() keeps the CPU
+     * Called right after run(); the simulator guarantees that no process arrives or finishes within the
+     * next maxTicks time steps, so the scheduler only has to account for its own decision points
+     * (e.g. the end of a time quantum)
+     * Must not change the scheduler's state: with several CPUs the simulator takes the smallest answer, and
+     * the next call to run() sees how long each process actually ran through its timeScheduled
+     * The default of a single time step is always correct, but makes the simulation tick every time unit
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps (between 1 and maxTicks) that the choice from run() holds for
+     */
+    virtual int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return 1;
+    }
+
+    /**
+     * Chooses the next process for one of several CPUs that share this scheduler's ready set
+     * Processes that are running on a CPU are never in the ready set, so each CPU gets a different process
+     * Schedulers that keep per-CPU state (such as the progress through a time quantum) override this; the
+     * default ignores the CPU and calls run()
+     * @param cpu The CPU to choose a process for, counting from 0
+     * @param currentProcess The index of the process on that CPU, or -1 if the CPU is free
+     * @param currentTime The total time accumulated by the CPU so far
+     * @param processes The table of processes for the scheduler to choose from
+     * @return Index of the process in the list that should run on the CPU at the next time step
+     */
+    virtual int runOnCpu(int cpu, int currentProcess, int currentTime, ProcessTable& processes) {
+        return run(currentProcess, currentTime, processes);
+    }
+
+    /**
+     * Per-CPU counterpart of fastForward(), called right after runOnCpu() for the same CPU
+     * @param cpu The CPU the choice was made for
+     * @param currentProcess The index returned by the last call to runOnCpu() for the CPU
+     * @param currentTime The time passed to the last call to runOnCpu()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps (between 1 and maxTicks) that the choice holds for
+     */
+    virtual int fastForwardOnCpu(int cpu, int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return fastForward(currentProcess, currentTime, maxTicks, processes);
+    }
+
+    /**
+     * Removes a waiting process so that an idle CPU with its own run queue can take it (work stealing)
+     * The running process is never stolen
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    virtual int steal(int currentTime, ProcessTable& processes) {
+        return -1;
+    }
+
+    /**
+     * Makes a copy of the scheduler, including every process waiting in its ready set, so that a simulation
+     * can be continued from a snapshot while the original carries on
+     * @return The copy, which the caller deletes
+     */
+    virtual Scheduler* clone() const = 0;
+
+    /**
+     * Reports how many processes are waiting in each of the scheduler's ready queues, for the event counters
+     * Processes running on a CPU are not waiting, so they are not counted
+     * Schedulers with priority levels report one queue per level, starting with level 1
+     * @param depths Set to the number of waiting processes in each queue, or left empty if the scheduler has none
+     */
+    virtual void queueDepths(vector<int>& depths) const {
+        depths.clear();
+    }
 
 };
 
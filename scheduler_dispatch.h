@@ -0,0 +1,89 @@
+#ifndef SCHEDULER_DISPATCH_H
+#define SCHEDULER_DISPATCH_H
+
+#include <vector>
+
+#include "process.h"
+#include "scheduler.h"
+#include "scheduling_algorithms/first_in_first_out.h"
+#include "scheduling_algorithms/shortest_process_next.h"
+#include "scheduling_algorithms/shortest_remaining_time.h"
+#include "scheduling_algorithms/highest_response_ratio_next.h"
+#include "scheduling_algorithms/round_robin.h"
+#include "scheduling_algorithms/multilevel.h"
+#include "scheduling_algorithms/multilevel_feedback.h"
+#include "scheduling_algorithms/rate_monotonic.h"
+#include "scheduling_algorithms/earliest_deadline_first.h"
+
+using namespace std;
+
+/**
+ * @param schedulers Schedulers that are all of the given concrete type
+ * @return The same schedulers, as pointers to that type
+ */
+template<class SchedulerType>
+vector<SchedulerType*> concreteSchedulers(const vector<Scheduler*>& schedulers) {
+    vector<SchedulerType*> concrete(schedulers.size());
+    for(unsigned int i = 0; i < schedulers.size(); i++) {
+        concrete[i] = static_cast<SchedulerType*>(schedulers[i]);
+    }
+    return concrete;
+}
+
+/**
+ * Calls a function with schedulers made by createSchedulers(), as pointers to their concrete type
+ * Code templated on the scheduler type, such as BasicSimulator, is then compiled for that type, and since every
+ * scheduler class is final its decisions are resolved at compile time and can be inlined
+ * The scheduler numbers follow promptForSchedulingAlgorithm; any other number gets the schedulers unchanged,
+ * so the function goes through the virtual methods
+ * @param processType The type of processes the schedulers were made for
+ * @param schedulerType The number of the scheduling algorithm the schedulers were made with
+ * @param schedulers The schedulers
+ * @param function The function to call, with a vector of scheduler pointers
+ * @return What the function returns
+ */
+template<class Function>
+auto visitSchedulers(ProcessType processType, int schedulerType, const vector<Scheduler*>& schedulers,
+                     Function&& function) {
+    switch(processType) {
+        case BATCH:
+            switch(schedulerType) {
+                case 1:
+                    return function(concreteSchedulers<FirstInFirstOut>(schedulers));
+                case 2:
+                    return function(concreteSchedulers<ShortestProcessNext>(schedulers));
+                case 3:
+                    return function(concreteSchedulers<ShortestRemainingTime>(schedulers));
+                case 4:
+                    return function(concreteSchedulers<HighestResponseRatioNext>(schedulers));
+            }
+            break;
+        case INTERACTIVE:
+            switch(schedulerType) {
+                case 1:
+                    return function(concreteSchedulers<RoundRobin>(schedulers));
+                case 2:
+                    return function(concreteSchedulers<Multilevel>(schedulers));
+                case 3:
+                    return function(concreteSchedulers<MultilevelFeedback>(schedulers));
+                case 4:
+                    return function(concreteSchedulers<FirstInFirstOut>(schedulers));
+            }
+            break;
+        case REALTIME:
+            switch(schedulerType) {
+                case 1:
+                    return function(concreteSchedulers<RateMonotonic>(schedulers));
+                case 2:
+                    return function(concreteSchedulers<EarliestDeadlineFirst>(schedulers));
+                case 3:
+                    return function(concreteSchedulers<FirstInFirstOut>(schedulers));
+            }
+            break;
+        default:
+            break;
+    }
+    return function(schedulers);
+}
+
+#endif //SCHEDULER_DISPATCH_H
@@ -2,46 +2,93 @@
 #define EARLIEST_DEADLINE_FIRST_H
 
 #include "../scheduler.h"
-#include "../process.h"
-#include "../realtime_process.h"
+#include "../process_table.h"
+#include "ready_heap.h"
 
 /**
  * Scheduler that implements the Earliest Deadline First (EDF) algorithm
  * EDF is a preemptive scheduling algorithm
  */
-class EarliestDeadlineFirst: public Scheduler {
+class EarliestDeadlineFirst final : public Scheduler {
 
 public:
 
+    ReadyHeap readyProcesses;  // processes that are waiting to run
+
     /**
      * Chooses the process with the shortest amount of time before its deadline
+     * Processes that are waiting to run are kept in a heap keyed on their deadlines, so a choice takes O(log n)
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
 
         int index = -1;
-        int minDeadline = 9999999;
-
-        for(unsigned int i = 0; i < processList.size(); i++) {
-
-            RealtimeProcess* process = reinterpret_cast<RealtimeProcess*>(processList.at(i));
-            // only consider processes that have arrived and are not done
-            if(process->hasArrived && !process->isDone) {
-                // Get the process with the minimum deadline
-                if(process->deadline < minDeadline) {
-                    index = i;  // select the process
-                    minDeadline = process->deadline;  // update the minimum
-                }
+
+        if(currentProcess >= 0 && processes.isRunnable(currentProcess)) {
+            // the current process keeps running unless a waiting process has a lower deadline
+            index = currentProcess;
+            if(readyProcesses.topPrecedes(processes.deadline[currentProcess], currentProcess)) {
+                index = readyProcesses.pop();  // select the waiting process
+                readyProcesses.push(processes.deadline[currentProcess], currentProcess);  // the preempted process waits again
             }
+        } else if(!readyProcesses.empty()) {
+            // otherwise, select the waiting process with the lowest deadline
+            index = readyProcesses.pop();
         }
 
         return index;
 
     }
 
+    /**
+     * Gives away the waiting process that would run next
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        return readyProcesses.empty() ? -1 : readyProcesses.pop();
+    }
+
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    EarliestDeadlineFirst* clone() const {
+        return new EarliestDeadlineFirst(*this);
+    }
+
+    /**
+     * Reports the single ready queue
+     * @param depths Set to the number of waiting processes
+     */
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(1, readyProcesses.size());
+    }
+
+    /**
+     * Adds a newly arrived process to the ready heap, keyed on its deadline
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        readyProcesses.push(processes.deadline[processIndex], processIndex);
+    }
+
+    /**
+     * Deadlines do not change while a process runs, so EDF keeps its choice until a process arrives or finishes
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return maxTicks;
+    }
+
 };
 
 #endif //EARLIEST_DEADLINE_FIRST_H
@@ -1,9 +1,8 @@
 #ifndef FIRST_IN_FIRST_OUT_H
 #define FIRST_IN_FIRST_OUT_H
 
-#include <deque>
-
 #include "../scheduler.h"
+#include "ready_queue.h"
 
 using namespace std;
 
@@ -11,48 +10,88 @@ using namespace std;
  * Scheduler that implements the First-In First-Out (FIFO) algorithm
  * FIFO is a non-preemptive scheduling algorithm
  */
-class FirstInFirstOut: public Scheduler {
+class FirstInFirstOut final : public Scheduler {
 
 public:
 
-    deque<int> readyProcesses;
-
+    ReadyQueue readyProcesses;  // processes that are waiting to run, in order of arrival
 
     /**
      * Chooses the first process that arrives at the CPU
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
 
         int index = -1;
 
-        for(unsigned int i = 0; i < processList.size(); i++) {
-            // insert newly arrived processes that are not done into the queue
-            if(processList.at(i)->arrivalTime == currentTime && !processList.at(i)->isDone) {
-                readyProcesses.push_back(i);
+        // Select a new process if the CPU is free or the previous one finished or blocked, or leave the CPU idle if none are waiting
+        if(currentProcess < 0 || !processes.isRunnable(currentProcess)) {
+            if(!readyProcesses.empty()) {
+                // index of the next process to run is stored at the front of queue
+                index = readyProcesses.front();
+                readyProcesses.pop_front();
             }
-        }
-
-        // Select a new process if the CPU is free and there are processes ready to run
-        if(currentProcess < 0 && !readyProcesses.empty()) {
-            // index of the next process to run is stored at the front of queue
-            index = readyProcesses.front();
-            readyProcesses.pop_front();
-        } else if(currentProcess >= 0 && processList.at(currentProcess)->isDone) {
-            // Select a new process if the previous one finishes
-            index = readyProcesses.front();
-            readyProcesses.pop_front();
         } else {  // otherwise, continue until the current process is finished
             index = currentProcess;
         }
 
+        return index;
+    }
 
+    /**
+     * Adds a newly arrived process to the back of the queue
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        readyProcesses.push_back(processIndex);
+    }
+
+    /**
+     * Gives away the process that arrived last, which would otherwise wait the longest
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        if(readyProcesses.empty()) {
+            return -1;
+        }
+        int index = readyProcesses.back();
+        readyProcesses.pop_back();
         return index;
     }
 
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    FirstInFirstOut* clone() const {
+        return new FirstInFirstOut(*this);
+    }
+
+    /**
+     * Reports the single ready queue
+     * @param depths Set to the number of waiting processes
+     */
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(1, readyProcesses.size());
+    }
+
+    /**
+     * FIFO only makes a new decision when a process arrives or the current process finishes
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return maxTicks;
+    }
+
 };
 
 #endif //FIRST_IN_FIRST_OUT_H
@@ -1,57 +1,197 @@
 #ifndef HIGHEST_RESPONSE_RATIO_NEXT_H
 #define HIGHEST_RESPONSE_RATIO_NEXT_H
 
+#include <vector>
+
 #include "../scheduler.h"
+#include "response_ratio_tree.h"
+
+// Builds made with -DHRRN_VERIFY also make every choice with a scan over all waiting processes, and stop with an
+// error if the two choices differ
+#ifdef HRRN_VERIFY
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#endif
+
+using namespace std;
 
 /**
  * Scheduler that implements the Highest Response Ratio Next (HRRN) algorithm
  * HRRN is a non-preemptive scheduling algorithm
  */
-class HighestResponseRatioNext: public Scheduler {
+class HighestResponseRatioNext final : public Scheduler {
 
 public:
 
+    ResponseRatioTree readyProcesses;  // processes that have arrived and are waiting to run
+
     /**
      * Chooses the process with the highest response ratio
      * Ratio = (time spent waiting + expected service time) / (expected service time)
+     * The ratios grow with time, so the waiting processes are kept in a kinetic tree that only revisits the
+     * processes whose order has changed since the last choice, making a choice O(log n) amortized instead of a
+     * scan over every waiting process
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
 
         int index = currentProcess;
 
         // HRRN is a non-preemptive algorithm, so do not choose a new process unless
-        // there is no currently running process or the current process just finished
-        if(currentProcess < 0 || processList.at(currentProcess)->isDone) {
-            // find the process with the greatest ratio
-            int maxRatio = -1;
-            for(int i = 0; i < processList.size(); i++) {
-                // only consider processes that have arrived at the CPU
-                if (currentTime >= processList.at(i)->arrivalTime) {
-                    // only consider processes that are not done
-                    if (!processList.at(i)->isDone) {
-
-                        // Compute the ratio for the process
-                        // Ratio = (time spent waiting + expected service time) / (expected service time)
-                        double timeWaiting = (currentTime - processList.at(i)->arrivalTime) - processList.at(i)->timeScheduled;
-                        double expectedTime = processList.at(i)->totalTimeNeeded;
-                        double ratio = (timeWaiting + expectedTime) / expectedTime;
-
-                        // choose this process if it is higher than the maximum found so far
-                        if(ratio > maxRatio) {
-                            index = i;  // select the process
-                            maxRatio = ratio;  // set the new maximum
-                        }
-                    }
-                }
+        // there is no currently running process or the current process just finished or blocked on I/O
+        if((currentProcess < 0 || !processes.isRunnable(currentProcess)) && !readyProcesses.empty()) {
+            index = takeHighestRatio(currentTime, processes);
+        }
+
+        return index;
+    }
+
+    /**
+     * Adds a newly arrived process to the ready set
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        int expectedTime = processes.totalTimeNeeded[processIndex];
+        readyProcesses.insert(processIndex,
+                              static_cast<long long>(processes.arrivalTime[processIndex]) +
+                              processes.timeScheduled[processIndex] - expectedTime, expectedTime);
+#ifdef HRRN_VERIFY
+        verifyProcesses.push_back(processIndex);
+#endif
+    }
+
+    /**
+     * Gives away the waiting process that would run next
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        return readyProcesses.empty() ? -1 : takeHighestRatio(currentTime, processes);
+    }
+
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    HighestResponseRatioNext* clone() const {
+        return new HighestResponseRatioNext(*this);
+    }
+
+    /**
+     * Reports the single ready queue
+     * @param depths Set to the number of waiting processes
+     */
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(1, readyProcesses.size());
+    }
+
+    /**
+     * HRRN is non-preemptive, so its choice only changes when a process arrives or the current process finishes
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return maxTicks;
+    }
+
+private:
+
+#ifdef HRRN_VERIFY
+    vector<int> verifyProcesses;  // the same waiting processes, in no particular order, for the scan to check
+#endif
+
+    /**
+     * Removes and returns the waiting process with the greatest ratio
+     * The choice matches a scan over the whole table in order of index that keeps the running maximum as an
+     * int: the last process whose ratio is above the greatest whole part of any ratio wins, or else the
+     * first process whose ratio is exactly that whole number
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the chosen process
+     */
+    int takeHighestRatio(int currentTime, ProcessTable& processes) {
+
+        readyProcesses.advance(currentTime);
+        long long maxWholeRatio = readyProcesses.wholeRatio(readyProcesses.highest());
+        int index = readyProcesses.lastAbove(maxWholeRatio);
+        if(index < 0) {
+            index = readyProcesses.firstReaching(maxWholeRatio);
+        }
+        readyProcesses.erase(index);
+
+#ifdef HRRN_VERIFY
+        int scanned = scanHighestRatio(currentTime, processes);
+        if(scanned != index) {
+            cerr << "HRRN chose process " << index + 1 << " at time " << currentTime << ", but a scan chose process "
+                 << scanned + 1 << ", terminating program" << endl;
+            exit(-1);
+        }
+#endif
+
+        return index;
+    }
+
+#ifdef HRRN_VERIFY
+
+    /**
+     * Compute the response ratio of a waiting process
+     * Ratio = (time spent waiting + expected service time) / (expected service time)
+     * @param processIndex The index of the process
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The response ratio
+     */
+    static double responseRatio(int processIndex, int currentTime, ProcessTable& processes) {
+        double timeWaiting = (currentTime - processes.arrivalTime[processIndex]) - processes.timeScheduled[processIndex];
+        double expectedTime = processes.totalTimeNeeded[processIndex];
+        return (timeWaiting + expectedTime) / expectedTime;
+    }
+
+    /**
+     * Removes and returns the waiting process with the greatest ratio by computing the ratio of every waiting
+     * process, as HRRN chose before it kept the kinetic tree
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the chosen process
+     */
+    int scanHighestRatio(int currentTime, ProcessTable& processes) {
+
+        // the greatest whole part of any ratio
+        double maxWholeRatio = -1;
+        for(unsigned int i = 0; i < verifyProcesses.size(); i++) {
+            maxWholeRatio = max(maxWholeRatio, floor(responseRatio(verifyProcesses[i], currentTime, processes)));
+        }
+
+        int lastAbove = -1;  // position of the highest index whose ratio is above maxWholeRatio
+        int firstEqual = -1;  // position of the lowest index whose ratio equals maxWholeRatio
+        for(unsigned int i = 0; i < verifyProcesses.size(); i++) {
+            int index = verifyProcesses[i];
+            double ratio = responseRatio(index, currentTime, processes);
+            if(ratio > maxWholeRatio && (lastAbove < 0 || index > verifyProcesses[lastAbove])) {
+                lastAbove = i;
+            } else if(ratio == maxWholeRatio && (firstEqual < 0 || index < verifyProcesses[firstEqual])) {
+                firstEqual = i;
             }
         }
 
+        int position = lastAbove >= 0 ? lastAbove : firstEqual;
+        int index = verifyProcesses[position];
+
+        // swap the chosen process with the last one so it can be removed in constant time
+        verifyProcesses[position] = verifyProcesses.back();
+        verifyProcesses.pop_back();
+
         return index;
     }
+#endif
 
 };
 
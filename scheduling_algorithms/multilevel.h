@@ -2,106 +2,123 @@
 #define MULTILEVEL_H
 
 #include <vector>
-#include <map>
+#include <algorithm>
 
 #include "../scheduler.h"
-#include "../interactive_process.h"
-#include "round_robin.h"
+#include "priority_levels.h"
 
 using namespace std;
 
 const int ML_NUM_LEVELS = 5;
 const int ML_TIME_QUANTUM = 10;
 
-/**
- * Data structure for a priority level for Multilevel
- */
-struct Level {
-    int priority = 0;  // the level's relative priority
-    vector<Process*> processes;  // the processes in the level
-    RoundRobin* roundRobinScheduler;  // RR for scheduling within the level
-};
-
 /**
  * Scheduler that implements the Multilevel (ML) algorithm
  * ML is a preemptive scheduling algorithm
+ * Each process stays on the level that matches its priority, and the highest level with a process that is
+ * ready runs it using Round Robin scheduling
  */
-class Multilevel: public Scheduler {
+class Multilevel final : public Scheduler {
 
 public:
 
-    map<int, Level> levels;  // maps priority to the corresponding level
+    PriorityLevels levels;  // the ready queue of every priority level
     int timeQuantum = 0;
 
     /**
      * Constructor for a Multilevel scheduler
-     * @param processList The list of processes
+     * @param timeQuantum The time quantum for Round Robin scheduling within each level
      */
-    Multilevel(vector<Process*>& processList) {
-        timeQuantum = ML_TIME_QUANTUM;
-
-        // initialize data structures for levels
-        for(int i = 1; i <= ML_NUM_LEVELS; i++) {
-            Level newLevel;
-            newLevel.priority = i;
-            newLevel.roundRobinScheduler = new RoundRobin;
-            levels.insert(pair<int, Level>(i, newLevel));  // add level to the map
-        }
-
-        // sort processes into different priority levels
-        for(int i = 0; i < processList.size(); i++) {
-            InteractiveProcess* process = reinterpret_cast<InteractiveProcess*>(processList.at(i));
-            // clamp priorities that are too low or too high
-            if(process->priority < 1) {
-                process->priority = 1;
-            } else if(process->priority > ML_NUM_LEVELS) {
-                process->priority = ML_NUM_LEVELS;
-            }
-            // insert the process into the corresponding level
-            levels.at(process->priority).processes.push_back(processList.at(i));
-        }
+    Multilevel(int timeQuantum = ML_TIME_QUANTUM) : levels(vector<int>(ML_NUM_LEVELS, timeQuantum), true, false) {
+        this->timeQuantum = timeQuantum;
     }
 
     /**
      * Chooses the process at the highest priority level using Round Robin scheduling
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
-
-        int index = -1;
-
-        // For every level, update which processes have arrived at the CPU
-        for(int p = ML_NUM_LEVELS; p > 0; p--) {
-            vector<Process*> priorityProcesses = levels.at(p).processes;
-            levels.at(p).roundRobinScheduler->updateReadyProcesses(currentTime, priorityProcesses);
-        }
-
-        // Start at the highest priority level
-        for(int p = ML_NUM_LEVELS; p > 0; p--) {
-
-            // Retrieve the list of processes for this level
-            vector<Process*> priorityProcesses = levels.at(p).processes;
-
-            // Run round robin scheduling on the current priority level
-            int roundRobinResult = levels.at(p).roundRobinScheduler->getNextProcess(priorityProcesses);
-
-            if(roundRobinResult >= 0) {
-                // Get the id of the process that round robin returned
-                string roundRobinId = priorityProcesses.at(roundRobinResult)->id;
-                // Find the corresponding id in the actual process array to get the real index
-                for(int i = 0; i < processList.size(); i++) {
-                    if(roundRobinId == processList.at(i)->id) {
-                        index = i;  // select index without being relative to a priority level
-                    }
-                }
-                break;  // do not continue searching for processes in lower priority levels
-            }
-        }
-
-        return index;
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
+        return levels.nextProcess(0, processes);
+    }
+
+    /**
+     * Chooses the process at the highest priority level for one of several CPUs
+     * @param cpu The CPU to choose a process for
+     * @param currentProcess The index of the process on that CPU, or -1 if the CPU is free
+     * @param currentTime The total time accumulated by the CPU so far
+     * @param processes The table of processes for the scheduler to choose from
+     * @return Index of the process in the list that should run on the CPU at the next time step
+     */
+    int runOnCpu(int cpu, int currentProcess, int currentTime, ProcessTable& processes) {
+        return levels.nextProcess(cpu, processes);
+    }
+
+    /**
+     * Levels above the selected one are empty and levels below it are not consulted, so the selection
+     * holds until the end of the process's time quantum
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return fastForwardOnCpu(0, currentProcess, currentTime, maxTicks, processes);
+    }
+
+    /**
+     * Per-CPU counterpart of fastForward()
+     * @param cpu The CPU the choice was made for
+     * @param currentProcess The index returned by the last call to runOnCpu() for the CPU
+     * @param currentTime The time passed to the last call to runOnCpu()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from runOnCpu() holds for
+     */
+    int fastForwardOnCpu(int cpu, int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        int timeLeft = levels.timeLeft(cpu, processes);
+        // the CPU stays idle until the next arrival
+        return timeLeft < 0 ? maxTicks : min(maxTicks, timeLeft);
+    }
+
+    /**
+     * Adds a newly arrived process to the level that matches its priority
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        // clamp priorities that are too low or too high
+        int priority = min(max(processes.priority[processIndex], 1), ML_NUM_LEVELS);
+        // insert the process into the corresponding level
+        levels.add(processIndex, priority, processes);
+    }
+
+    /**
+     * Gives away a waiting process from the highest priority level that has one
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        return levels.steal();
+    }
+
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    Multilevel* clone() const {
+        return new Multilevel(*this);
+    }
+
+    /**
+     * Reports the ready queue of every priority level
+     * @param depths Set to the number of waiting processes on each level, starting with level 1
+     */
+    void queueDepths(vector<int>& depths) const {
+        levels.queueDepths(depths);
     }
 
 };
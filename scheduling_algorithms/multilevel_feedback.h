@@ -2,108 +2,136 @@
 #define MULTILEVEL_FEEDBACK_H
 
 #include <vector>
-#include <map>
-#include <cmath>
+#include <algorithm>
 
 #include "../scheduler.h"
-#include "../interactive_process.h"
-#include "round_robin.h"
+#include "priority_levels.h"
 
 using namespace std;
 
 const int MLF_NUM_LEVELS = 5;
 const int MLF_TIME_QUANTUM = 10;
 
-struct FeedbackLevel {
-    int priority = 0;  // the level's relative priority
-    vector<Process*> processes;  // the processes in the level
-    int timeQuantum = MLF_TIME_QUANTUM;  // each level has its own time quantum
-    RoundRobin* roundRobinScheduler;  // RR for scheduling within the level
-};
-
 /**
  * Scheduler that implements the Multilevel Feedback (MLF) algorithm
  * MLF is a preemptive scheduling algorithm
+ * Processes start on the level that matches their priority and move down a level every time they use up a
+ * whole time quantum, so long-running processes give way to short ones
  */
-class MultilevelFeedback: public Scheduler {
+class MultilevelFeedback final : public Scheduler {
 
 public:
 
-    map<int, FeedbackLevel> levels;  // maps priority to the corresponding level
+    PriorityLevels levels;  // the ready queue of every priority level
 
     /**
      * Constructor for a Multilevel Feedback scheduler
-     * @param processList The list of processes
+     * @param baseQuantum The time quantum of the highest priority level
      */
-    MultilevelFeedback(vector<Process*>& processList) {
-
-        // initialize data structures for levels
-        for(int i = 1; i <= MLF_NUM_LEVELS; i++) {
-            FeedbackLevel newLevel;
-            newLevel.priority = i;
-            // Compute the time quantum for the priority level
-            // Lower levels have exponentially higher time quanta
-            newLevel.timeQuantum = pow(2, i - 1) * MLF_TIME_QUANTUM;
-            // Initialize the level's Round Robin with the calculated time quantum
-            newLevel.roundRobinScheduler = new RoundRobin(newLevel.timeQuantum);
-            levels.insert(pair<int, FeedbackLevel>(i, newLevel));  // add level to the map
-        }
-
-        // sort processes into different priority levels
-        for(int i = 0; i < processList.size(); i++) {
-            InteractiveProcess* process = reinterpret_cast<InteractiveProcess*>(processList.at(i));
-            // clamp priorities that are too low or too high
-            if(process->priority < 1) {
-                process->priority = 1;
-            } else if(process->priority > MLF_NUM_LEVELS) {
-                process->priority = MLF_NUM_LEVELS;
-            }
-
-            // insert the process into the corresponding level
-            levels.at(process->priority).processes.push_back(processList.at(i));
-        }
-    }
+    MultilevelFeedback(int baseQuantum = MLF_TIME_QUANTUM) : levels(timeQuanta(baseQuantum), false, true) {}
 
     /**
      * Chooses the process at the highest priority level using Round Robin scheduling
      * Sends processes to lower priority levels as they surpass their respective time quanta
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
+        return levels.nextProcess(0, processes);
+    }
 
-        int index = -1;
+    /**
+     * Chooses the process at the highest priority level for one of several CPUs
+     * @param cpu The CPU to choose a process for
+     * @param currentProcess The index of the process on that CPU, or -1 if the CPU is free
+     * @param currentTime The total time accumulated by the CPU so far
+     * @param processes The table of processes for the scheduler to choose from
+     * @return Index of the process in the list that should run on the CPU at the next time step
+     */
+    int runOnCpu(int cpu, int currentProcess, int currentTime, ProcessTable& processes) {
+        return levels.nextProcess(cpu, processes);
+    }
 
-        // For every level, update which processes have arrived at the CPU
-        for(int p = MLF_NUM_LEVELS; p > 0; p--) {
-            vector<Process*> priorityProcesses = levels.at(p).processes;
-            levels.at(p).roundRobinScheduler->updateReadyProcesses(currentTime, priorityProcesses);
-        }
+    /**
+     * The selection holds until the end of the process's time quantum, when it may be demoted
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return fastForwardOnCpu(0, currentProcess, currentTime, maxTicks, processes);
+    }
 
-        // Start at the highest priority level
-        for(int p = MLF_NUM_LEVELS; p > 0; p--) {
-
-            vector<Process*> priorityProcesses = levels.at(p).processes;
-
-            // Run round robin scheduling on the current priority level with the corresponding time quantum
-            int roundRobinResult = levels.at(p).roundRobinScheduler->getNextProcess(priorityProcesses);
-
-            if(roundRobinResult >= 0) {
-                // Get the id of the process that round robin returned
-                string roundRobinId = priorityProcesses.at(roundRobinResult)->id;
-                // Find the corresponding id in the actual process array to get the real index
-                for(int i = 0; i < processList.size(); i++) {
-                    if(roundRobinId == processList.at(i)->id) {
-                        index = i;  // select index without being relative to a priority level
-                    }
-                }
-                break;  // do not continue to lower priority levels
-            }
-        }
+    /**
+     * Per-CPU counterpart of fastForward()
+     * @param cpu The CPU the choice was made for
+     * @param currentProcess The index returned by the last call to runOnCpu() for the CPU
+     * @param currentTime The time passed to the last call to runOnCpu()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from runOnCpu() holds for
+     */
+    int fastForwardOnCpu(int cpu, int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        int timeLeft = levels.timeLeft(cpu, processes);
+        // the CPU stays idle until the next arrival
+        return timeLeft < 0 ? maxTicks : min(maxTicks, timeLeft);
+    }
 
-        return index;
+    /**
+     * Adds a newly arrived process to the level that matches its priority
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        // clamp priorities that are too low or too high
+        int priority = min(max(processes.priority[processIndex], 1), MLF_NUM_LEVELS);
+        // insert the process into the corresponding level
+        levels.add(processIndex, priority, processes);
+    }
+
+    /**
+     * Gives away a waiting process from the highest priority level that has one
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        return levels.steal();
+    }
+
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    MultilevelFeedback* clone() const {
+        return new MultilevelFeedback(*this);
+    }
+
+    /**
+     * Reports the ready queue of every priority level
+     * @param depths Set to the number of waiting processes on each level, starting with level 1
+     */
+    void queueDepths(vector<int>& depths) const {
+        levels.queueDepths(depths);
+    }
+
+private:
+
+    /**
+     * Compute the time quantum of every priority level
+     * Lower levels have exponentially higher time quanta, so demoted processes run for longer once they get the CPU
+     * @param baseQuantum The time quantum of the highest priority level
+     * @return The time quantum of each level, starting with the lowest priority level
+     */
+    static vector<int> timeQuanta(int baseQuantum) {
+        vector<int> quanta(MLF_NUM_LEVELS);
+        for(int i = 1; i <= MLF_NUM_LEVELS; i++) {
+            quanta[i - 1] = baseQuantum << (MLF_NUM_LEVELS - i);
+        }
+        return quanta;
     }
 
 };
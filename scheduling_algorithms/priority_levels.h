@@ -0,0 +1,332 @@
+#ifndef PRIORITY_LEVELS_H
+#define PRIORITY_LEVELS_H
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#include "../process_table.h"
+
+using namespace std;
+
+/**
+ * Round Robin ready queues for a fixed set of priority levels, used by Multilevel and Multilevel Feedback
+ * Modelled on the O(1) scheduler: a bitmap has a bit set for every level that has waiting processes, so the
+ * highest one is found with a single find-last-set instead of visiting every level, and each level's queue
+ * is an intrusive doubly linked list threaded through per-process links, so queue operations never copy
+ * or allocate
+ * Levels are numbered from 1 (lowest priority) to the number of levels (highest priority)
+ * Within a level, processes take turns exactly as with RoundRobin, including its handling of several CPUs
+ */
+class PriorityLevels {
+
+public:
+
+    /**
+     * Constructor for a set of priority levels
+     * @param timeQuanta The time quantum of each level, starting with level 1
+     * @param fullQuantumAtStart Whether the first process to run on a level gets a full time quantum
+     *                           (RoundRobin()) or is sent to the back of the queue first (RoundRobin(int))
+     * @param demoteOnExpiry Whether a process that uses up its time quantum moves down one level
+     */
+    PriorityLevels(const vector<int>& timeQuanta, bool fullQuantumAtStart, bool demoteOnExpiry) {
+
+        numLevels = timeQuanta.size();
+        if(numLevels < 1 || numLevels > MAX_LEVELS) {
+            cerr << "Invalid number of priority levels: " << numLevels << endl;
+            exit(-1);
+        }
+
+        this->timeQuanta.push_back(0);  // there is no level 0
+        this->timeQuanta.insert(this->timeQuanta.end(), timeQuanta.begin(), timeQuanta.end());
+        this->demoteOnExpiry = demoteOnExpiry;
+        initialFullQuantumLevels = fullQuantumAtStart ? levelsUpTo(numLevels) & ~1u : 0;
+        heads.assign(numLevels + 1, -1);
+        tails.assign(numLevels + 1, -1);
+        lengths.assign(numLevels + 1, 0);
+    }
+
+    /**
+     * @return The number of priority levels
+     */
+    int size() const {
+        return numLevels;
+    }
+
+    /**
+     * Adds a process to the back of a level's queue
+     * @param processIndex The index of the process
+     * @param priority The level to add it to, between 1 and the number of levels
+     * @param processes The table of processes
+     */
+    void add(int processIndex, int priority, ProcessTable& processes) {
+        if(next.size() < processes.size()) {
+            next.resize(processes.size(), -1);
+            previous.resize(processes.size(), -1);
+            level.resize(processes.size(), 0);
+            sliceStart.resize(processes.size(), -1);
+        }
+        level[processIndex] = priority;
+        pushBack(priority, processIndex);
+    }
+
+    /**
+     * Chooses the process to run on a CPU: the next process in Round Robin order on the highest level that has one
+     * The process that a lower level had on the CPU goes back to the front of that level's queue, keeping what
+     * is left of its time quantum
+     * @param cpu The CPU to choose a process for
+     * @param processes The table of processes
+     * @return Index of the process that should run on the CPU, or -1 if no process is waiting
+     */
+    int nextProcess(int cpu, ProcessTable& processes) {
+
+        if(static_cast<unsigned int>(cpu) >= running.size()) {
+            running.resize(cpu + 1, -1);
+            fullQuantumLevels.resize(cpu + 1, initialFullQuantumLevels);
+        }
+
+        int current = running[cpu];
+        bool currentLeft = current >= 0 && !processes.isRunnable(current);  // it finished or blocked on I/O
+
+        while(true) {
+
+            // the highest level with a process that can run: a waiting one, or the one already on the CPU
+            uint32_t candidates = readyLevels;
+            if(current >= 0 && !currentLeft) {
+                candidates |= levelBit(level[current]);
+            }
+            int top = highestLevel(candidates);
+
+            // levels above it are empty, so the next process to arrive on one of them waits for a rotation
+            fullQuantumLevels[cpu] &= levelsUpTo(top);
+            if(current >= 0 && level[current] > top) {
+                sliceStart[current] = -1;  // the finished process leaves with its level
+                running[cpu] = current = -1;
+            }
+
+            if(top == 0) {
+                return -1;  // no process to run
+            }
+
+            if(current >= 0 && level[current] == top) {
+                // the process keeps the CPU until the end of its time quantum
+                if(!currentLeft && quantumLeft(current, processes) > 0) {
+                    return current;
+                }
+
+                // move on to the next process in the level, and to the back of the queue if it isn't done
+                running[cpu] = -1;
+                sliceStart[current] = -1;
+                if(!currentLeft) {
+                    requeue(current, top);
+                }
+                current = -1;
+            } else {
+                if(current >= 0) {
+                    // a higher level takes the CPU from the process
+                    running[cpu] = -1;
+                    if(currentLeft) {
+                        // the next process on its level starts a full quantum, as if it had been rotated out
+                        sliceStart[current] = -1;
+                        fullQuantumLevels[cpu] |= levelBit(level[current]);
+                    } else {
+                        pushFront(level[current], current);
+                    }
+                    current = -1;
+                }
+
+                // the process at the front of the queue takes the CPU, resuming its quantum if it has one
+                int first = heads[top];
+                bool hasTimeLeft = sliceStart[first] >= 0 ? quantumLeft(first, processes) > 0
+                                                          : (fullQuantumLevels[cpu] & levelBit(top)) != 0;
+                if(hasTimeLeft) {
+                    remove(first);
+                    if(sliceStart[first] < 0) {
+                        sliceStart[first] = processes.timeScheduled[first];
+                    }
+                    running[cpu] = first;
+                    return first;
+                }
+
+                // otherwise it goes to the back of the queue first
+                remove(first);
+                bool usedQuantum = sliceStart[first] >= 0;
+                sliceStart[first] = -1;
+                if(usedQuantum) {
+                    requeue(first, top);
+                } else {
+                    pushBack(top, first);
+                }
+            }
+
+            if(heads[top] < 0) {
+                // the level has run out of processes, so look further down
+                fullQuantumLevels[cpu] &= ~levelBit(top);
+                continue;
+            }
+
+            // the next process in the queue starts a full time quantum
+            int index = heads[top];
+            remove(index);
+            sliceStart[index] = processes.timeScheduled[index];
+            running[cpu] = index;
+            return index;
+        }
+    }
+
+    /**
+     * @param cpu A CPU that nextProcess() was called for
+     * @param processes The table of processes
+     * @return The number of time steps left in the time quantum of the process on the CPU, or -1 if it has none
+     */
+    int timeLeft(int cpu, ProcessTable& processes) const {
+        if(static_cast<unsigned int>(cpu) >= running.size() || running[cpu] < 0) {
+            return -1;
+        }
+        return quantumLeft(running[cpu], processes);
+    }
+
+    /**
+     * Removes the process at the back of the highest level that has waiting processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal() {
+        int top = highestLevel(readyLevels);
+        if(top == 0) {
+            return -1;
+        }
+        int index = tails[top];
+        remove(index);
+        sliceStart[index] = -1;  // the process starts a new quantum wherever it runs next
+        return index;
+    }
+
+    /**
+     * @param depths Set to the number of processes waiting on each level, starting with level 1
+     */
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(lengths.begin() + 1, lengths.end());
+    }
+
+private:
+
+    static const int MAX_LEVELS = 31;  // bit 0 of the bitmaps is unused, since levels start at 1
+
+    int numLevels = 0;  // the number of priority levels
+    vector<int> timeQuanta;  // the time quantum of each level, indexed by level
+    bool demoteOnExpiry = false;  // whether processes that use up their quantum move down a level
+    uint32_t readyLevels = 0;  // bitmap of the levels whose queues are not empty
+    uint32_t initialFullQuantumLevels = 0;  // the value of fullQuantumLevels for a CPU that has not run yet
+    vector<int> heads;  // the first process in each level's queue, or -1 if it is empty
+    vector<int> tails;  // the last process in each level's queue, or -1 if it is empty
+    vector<int> lengths;  // the number of processes in each level's queue
+    vector<int> next;  // the process after each process in its queue, or -1 if it is last
+    vector<int> previous;  // the process before each process in its queue, or -1 if it is first
+    vector<int> level;  // the level each process belongs to
+    vector<int> sliceStart;  // each process's timeScheduled when its time quantum began, or -1 if it has none
+    vector<int> running;  // the process each CPU is running, or -1 if it has none
+    vector<uint32_t> fullQuantumLevels;  // for each CPU, bitmap of the levels whose next process starts right away
+
+    /**
+     * @param priority A level
+     * @return The bit for the level in a bitmap of levels
+     */
+    static uint32_t levelBit(int priority) {
+        return 1u << priority;
+    }
+
+    /**
+     * @param priority A level, or 0
+     * @return A bitmap of every level up to and including the given one
+     */
+    static uint32_t levelsUpTo(int priority) {
+        return (2u << priority) - 1;
+    }
+
+    /**
+     * Find-last-set on a bitmap of levels
+     * @param levels A bitmap of levels
+     * @return The highest level in the bitmap, or 0 if it is empty
+     */
+    static int highestLevel(uint32_t levels) {
+        return levels == 0 ? 0 : 31 - __builtin_clz(levels);
+    }
+
+    /**
+     * @param processIndex A process that has a time quantum
+     * @param processes The table of processes
+     * @return The number of time steps left in the process's time quantum
+     */
+    int quantumLeft(int processIndex, ProcessTable& processes) const {
+        return timeQuanta[level[processIndex]] - (processes.timeScheduled[processIndex] - sliceStart[processIndex]);
+    }
+
+    /**
+     * Puts a process that used up its time quantum at the back of a queue: its own level's, or with
+     * demotion the one below it
+     * @param processIndex The index of the process
+     * @param priority The level the process used up its quantum on
+     */
+    void requeue(int processIndex, int priority) {
+        if(demoteOnExpiry && priority > 1) {
+            level[processIndex] = priority - 1;
+        }
+        pushBack(level[processIndex], processIndex);
+    }
+
+    /**
+     * Adds a process to the back of a level's queue in O(1)
+     */
+    void pushBack(int priority, int processIndex) {
+        previous[processIndex] = tails[priority];
+        next[processIndex] = -1;
+        if(tails[priority] >= 0) {
+            next[tails[priority]] = processIndex;
+        } else {
+            heads[priority] = processIndex;
+        }
+        tails[priority] = processIndex;
+        lengths[priority]++;
+        readyLevels |= levelBit(priority);
+    }
+
+    /**
+     * Adds a process to the front of a level's queue in O(1)
+     */
+    void pushFront(int priority, int processIndex) {
+        previous[processIndex] = -1;
+        next[processIndex] = heads[priority];
+        if(heads[priority] >= 0) {
+            previous[heads[priority]] = processIndex;
+        } else {
+            tails[priority] = processIndex;
+        }
+        heads[priority] = processIndex;
+        lengths[priority]++;
+        readyLevels |= levelBit(priority);
+    }
+
+    /**
+     * Unlinks a process from its level's queue in O(1)
+     */
+    void remove(int processIndex) {
+        int priority = level[processIndex];
+        if(previous[processIndex] >= 0) {
+            next[previous[processIndex]] = next[processIndex];
+        } else {
+            heads[priority] = next[processIndex];
+        }
+        if(next[processIndex] >= 0) {
+            previous[next[processIndex]] = previous[processIndex];
+        } else {
+            tails[priority] = previous[processIndex];
+        }
+        lengths[priority]--;
+        if(heads[priority] < 0) {
+            readyLevels &= ~levelBit(priority);
+        }
+    }
+
+};
+
+#endif //PRIORITY_LEVELS_H
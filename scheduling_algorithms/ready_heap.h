@@ -0,0 +1,159 @@
+#ifndef READY_HEAP_H
+#define READY_HEAP_H
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+/**
+ * 4-ary min-heap of ready processes keyed on an integer (e.g. remaining time or deadline)
+ * Entries with equal keys are ordered by process index, so the top of the heap is always the process that a
+ * linear scan for the minimum key (keeping the first minimum it finds) would select
+ * Each entry packs its key and index into one 64-bit integer that orders the same way, so choosing between
+ * entries is a single comparison, and the four children of a node sit next to each other in memory and are
+ * compared without branches, which makes the heap shallower and quicker to sift through than a binary heap
+ * Used by the schedulers that always run the process with the smallest key
+ */
+class ReadyHeap {
+
+public:
+
+    /**
+     * Data structure for a process in the heap
+     */
+    struct Entry {
+        int key;  // the value the heap is ordered by
+        int index;  // the index of the process in the list of processes
+    };
+
+    /**
+     * @return Whether the heap has no processes in it
+     */
+    bool empty() const {
+        return entries.empty();
+    }
+
+    /**
+     * @return The number of processes in the heap
+     */
+    unsigned int size() const {
+        return entries.size();
+    }
+
+    /**
+     * @return The process with the smallest key
+     */
+    Entry top() const {
+        return unpack(entries.front());
+    }
+
+    /**
+     * Checks whether the top of the heap should be chosen over a process that is not in the heap
+     * @param key The key of the other process
+     * @param index The index of the other process
+     * @return Whether the top of the heap comes before the other process
+     */
+    bool topPrecedes(int key, int index) const {
+        return !entries.empty() && entries.front() < pack(key, index);
+    }
+
+    /**
+     * Adds a process to the heap in O(log n)
+     * @param key The key of the process
+     * @param index The index of the process
+     */
+    void push(int key, int index) {
+        uint64_t entry = pack(key, index);
+        unsigned int hole = entries.size();
+        entries.push_back(entry);
+
+        // move parents down until the new entry's place is found
+        while(hole > 0) {
+            unsigned int parent = (hole - 1) / ARITY;
+            if(entries[parent] < entry) {
+                break;
+            }
+            entries[hole] = entries[parent];
+            hole = parent;
+        }
+        entries[hole] = entry;
+    }
+
+    /**
+     * Removes the process with the smallest key in O(log n)
+     * @return The index of the removed process
+     */
+    int pop() {
+        int index = unpack(entries.front()).index;
+        uint64_t last = entries.back();
+        entries.pop_back();
+        if(!entries.empty()) {
+            siftDown(last);
+        }
+        return index;
+    }
+
+private:
+
+    static const unsigned int ARITY = 4;  // the number of children of each node
+
+    vector<uint64_t> entries;  // the heap, stored as an array, with the children of node i at ARITY * i + 1 onward
+
+    /**
+     * @param key The key of a process
+     * @param index The index of the process
+     * @return The entry for the process: the key, offset to be unsigned, above the index
+     */
+    static uint64_t pack(int key, int index) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(key) ^ 0x80000000u) << 32) | static_cast<uint32_t>(index);
+    }
+
+    /**
+     * @param entry An entry made by pack()
+     * @return The key and index of the process
+     */
+    static Entry unpack(uint64_t entry) {
+        return Entry{static_cast<int>(static_cast<uint32_t>(entry >> 32) ^ 0x80000000u), static_cast<int>(static_cast<uint32_t>(entry))};
+    }
+
+    /**
+     * Fills the empty root with an entry, moving smaller children up until the entry's place is found
+     * @param entry The entry to place, which is not in the heap
+     */
+    void siftDown(uint64_t entry) {
+        unsigned int size = entries.size();
+        unsigned int hole = 0;
+        while(true) {
+            unsigned int first = ARITY * hole + 1;
+            if(first >= size) {
+                break;
+            }
+
+            unsigned int smallest;
+            if(first + ARITY <= size) {
+                // every child is present, so compare them in pairs, which compiles to conditional moves
+                unsigned int a = entries[first + 1] < entries[first] ? first + 1 : first;
+                unsigned int b = entries[first + 3] < entries[first + 2] ? first + 3 : first + 2;
+                smallest = entries[b] < entries[a] ? b : a;
+            } else {
+                smallest = first;
+                for(unsigned int child = first + 1; child < size; child++) {
+                    if(entries[child] < entries[smallest]) {
+                        smallest = child;
+                    }
+                }
+            }
+
+            if(entry < entries[smallest]) {
+                break;
+            }
+            entries[hole] = entries[smallest];
+            hole = smallest;
+        }
+        entries[hole] = entry;
+    }
+
+};
+
+#endif //READY_HEAP_H
@@ -0,0 +1,116 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * Double-ended queue of process indices in a circular buffer, used by the schedulers that take turns in order
+ * Unlike deque, which allocates and frees a block every few hundred processes as the queue moves along, the
+ * buffer only grows (doubling when full) and keeps its memory, so a queue that has reached its largest size
+ * never allocates again
+ */
+class ReadyQueue {
+
+public:
+
+    /**
+     * @return Whether the queue has no processes in it
+     */
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * @return The number of processes in the queue
+     */
+    unsigned int size() const {
+        return count;
+    }
+
+    /**
+     * @return The process at the front of the queue
+     */
+    int front() const {
+        return buffer[head];
+    }
+
+    /**
+     * @return The process at the back of the queue
+     */
+    int back() const {
+        return buffer[wrap(head + count - 1)];
+    }
+
+    /**
+     * Adds a process to the back of the queue in amortized O(1)
+     * @param processIndex The index of the process
+     */
+    void push_back(int processIndex) {
+        if(count == buffer.size()) {
+            grow();
+        }
+        buffer[wrap(head + count)] = processIndex;
+        count++;
+    }
+
+    /**
+     * Adds a process to the front of the queue in amortized O(1)
+     * @param processIndex The index of the process
+     */
+    void push_front(int processIndex) {
+        if(count == buffer.size()) {
+            grow();
+        }
+        head = wrap(head + buffer.size() - 1);
+        buffer[head] = processIndex;
+        count++;
+    }
+
+    /**
+     * Removes the process at the front of the queue in O(1)
+     */
+    void pop_front() {
+        head = wrap(head + 1);
+        count--;
+    }
+
+    /**
+     * Removes the process at the back of the queue in O(1)
+     */
+    void pop_back() {
+        count--;
+    }
+
+private:
+
+    static const unsigned int INITIAL_CAPACITY = 64;  // the size of the buffer when the first process is added
+
+    vector<int> buffer;  // the processes, starting at head and wrapping around; its size is a power of two
+    unsigned int head = 0;  // the position in buffer of the front of the queue
+    unsigned int count = 0;  // the number of processes in the queue
+
+    /**
+     * @param position A position that may be past the end of the buffer
+     * @return The position wrapped around into the buffer
+     */
+    unsigned int wrap(unsigned int position) const {
+        return position & (buffer.size() - 1);
+    }
+
+    /**
+     * Doubles the size of the buffer, moving the processes to its start in order
+     */
+    void grow() {
+        vector<int> larger(buffer.empty() ? INITIAL_CAPACITY : 2 * buffer.size());
+        for(unsigned int i = 0; i < count; i++) {
+            larger[i] = buffer[wrap(head + i)];
+        }
+        buffer.swap(larger);
+        head = 0;
+    }
+
+};
+
+#endif //READY_QUEUE_H
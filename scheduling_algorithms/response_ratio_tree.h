@@ -0,0 +1,282 @@
+#ifndef RESPONSE_RATIO_TREE_H
+#define RESPONSE_RATIO_TREE_H
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Kinetic segment tree of waiting processes, used by HRRN to find the process with the highest response ratio
+ * While a process waits, its ratio (waiting + expected) / expected is the line (time - start) / expected, which
+ * grows at its own rate of 1 / expected; the processes are the leaves, in order of process index, and every node
+ * keeps the process with the highest ratio below it together with the earliest time that choice can change
+ * (when a faster growing process overtakes it). Moving time forward only recomputes the nodes whose choice
+ * expired, so the highest ratio is kept current in amortized O(log^2 n) per change, and adding or removing a
+ * process takes O(log n)
+ * Ratios are compared exactly in integer arithmetic
+ */
+class ResponseRatioTree {
+
+public:
+
+    /**
+     * @return Whether the tree has no processes in it
+     */
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * @return The number of processes in the tree
+     */
+    unsigned int size() const {
+        return count;
+    }
+
+    /**
+     * Adds a waiting process in O(log n), or amortized O(n) when the tree has to grow to fit its index
+     * @param processIndex The index of the process
+     * @param start The time at which the ratio of the process would be 0: its arrival time, plus the time it has
+     *              already run, minus its expected service time
+     * @param expected The expected service time of the process, which must be positive
+     */
+    void insert(int processIndex, long long start, long long expected) {
+        if(static_cast<unsigned int>(processIndex) >= numLeaves) {
+            grow(processIndex + 1);
+        }
+        lines[processIndex] = Line{start, expected};
+        winners[numLeaves + processIndex] = processIndex;
+        count++;
+        update(numLeaves + processIndex);
+    }
+
+    /**
+     * Removes a waiting process in O(log n)
+     * @param processIndex The index of the process, which must be in the tree
+     */
+    void erase(int processIndex) {
+        winners[numLeaves + processIndex] = -1;
+        count--;
+        update(numLeaves + processIndex);
+    }
+
+    /**
+     * Brings every node up to date with the time, which must not be earlier than the last time given
+     * @param time The current time
+     */
+    void advance(long long time) {
+        if(numLeaves == 0) {
+            now = time;
+        } else if(time < now) {
+            now = time;
+            rebuild();
+        } else {
+            now = time;
+            advanceNode(1);
+        }
+    }
+
+    /**
+     * @return The process with the highest ratio at the time last given to advance(), or -1 if the tree is empty
+     */
+    int highest() const {
+        return numLeaves > 0 ? winners[1] : -1;
+    }
+
+    /**
+     * @param processIndex A process in the tree
+     * @return The whole part of the ratio of the process at the time last given to advance()
+     */
+    long long wholeRatio(int processIndex) const {
+        const Line& line = lines[processIndex];
+        return floorDivide(now - line.start, line.expected);
+    }
+
+    /**
+     * Finds the process with the highest index whose ratio is above a whole number, in O(log n)
+     * @param whole The whole number
+     * @return The index of the process, or -1 if no ratio is above the whole number
+     */
+    int lastAbove(long long whole) const {
+        if(!isAbove(winners[1], whole)) {
+            return -1;
+        }
+        unsigned int node = 1;
+        while(node < numLeaves) {
+            node = isAbove(winners[2 * node + 1], whole) ? 2 * node + 1 : 2 * node;
+        }
+        return winners[node];
+    }
+
+    /**
+     * Finds the process with the lowest index whose ratio is at least a whole number, in O(log n)
+     * @param whole The whole number
+     * @return The index of the process, or -1 if no ratio reaches the whole number
+     */
+    int firstReaching(long long whole) const {
+        if(!reaches(winners[1], whole)) {
+            return -1;
+        }
+        unsigned int node = 1;
+        while(node < numLeaves) {
+            node = reaches(winners[2 * node], whole) ? 2 * node : 2 * node + 1;
+        }
+        return winners[node];
+    }
+
+private:
+
+    /**
+     * Data structure for the ratio of a waiting process over time, (time - start) / expected
+     */
+    struct Line {
+        long long start;  // the time at which the ratio would be 0
+        long long expected;  // the expected service time, the inverse of the rate the ratio grows at
+    };
+
+    static constexpr long long NEVER = LLONG_MAX;  // the expiry time of a choice that cannot change
+
+    vector<Line> lines;  // the ratio of each process, by process index
+    vector<int> winners;  // the process with the highest ratio below each node, or -1; the root is node 1 and
+                          // the leaves start at numLeaves
+    vector<long long> expiries;  // the earliest time the choice of any node below each node can change
+    unsigned int numLeaves = 0;  // the number of leaves, a power of two
+    unsigned int count = 0;  // the number of processes in the tree
+    long long now = 0;  // the time every node is up to date with
+
+    /**
+     * @param numerator The numerator
+     * @param denominator The denominator, which must be positive
+     * @return The numerator divided by the denominator, rounded down
+     */
+    static long long floorDivide(long long numerator, long long denominator) {
+        long long quotient = numerator / denominator;
+        return quotient * denominator > numerator ? quotient - 1 : quotient;
+    }
+
+    /**
+     * @param processIndex A process in the tree, or -1
+     * @param whole A whole number
+     * @return Whether the ratio of the process is above the whole number
+     */
+    bool isAbove(int processIndex, long long whole) const {
+        return processIndex >= 0 && now - lines[processIndex].start > whole * lines[processIndex].expected;
+    }
+
+    /**
+     * @param processIndex A process in the tree, or -1
+     * @param whole A whole number
+     * @return Whether the ratio of the process is at least the whole number
+     */
+    bool reaches(int processIndex, long long whole) const {
+        return processIndex >= 0 && now - lines[processIndex].start >= whole * lines[processIndex].expected;
+    }
+
+    /**
+     * Compares two processes at the current time
+     * @param a A process in the tree
+     * @param b Another process in the tree
+     * @return Whether a has the higher ratio, or the same ratio and grows at least as fast
+     */
+    bool beats(int a, int b) const {
+        long long ratioA = (now - lines[a].start) * lines[b].expected;
+        long long ratioB = (now - lines[b].start) * lines[a].expected;
+        return ratioA > ratioB || (ratioA == ratioB && lines[a].expected <= lines[b].expected);
+    }
+
+    /**
+     * @param winner A process that beats the loser at the current time
+     * @param loser The other process
+     * @return The first time at which the ratio of the loser is above that of the winner
+     */
+    long long overtakingTime(int winner, int loser) const {
+        const Line& w = lines[winner];
+        const Line& l = lines[loser];
+        if(l.expected >= w.expected) {
+            return NEVER;  // the loser grows no faster, so it never catches up
+        }
+        // (t - l.start) * w.expected > (t - w.start) * l.expected
+        long long rateDifference = w.expected - l.expected;
+        long long threshold = l.start * w.expected - w.start * l.expected;
+        return floorDivide(threshold, rateDifference) + 1;
+    }
+
+    /**
+     * Chooses the winner of a node from its children, which must be up to date
+     * @param node An internal node
+     */
+    void recompute(unsigned int node) {
+        int left = winners[2 * node];
+        int right = winners[2 * node + 1];
+        long long expiry = min(expiries[2 * node], expiries[2 * node + 1]);
+        if(left < 0 || right < 0) {
+            winners[node] = left < 0 ? right : left;
+        } else if(beats(left, right)) {
+            winners[node] = left;
+            expiry = min(expiry, overtakingTime(left, right));
+        } else {
+            winners[node] = right;
+            expiry = min(expiry, overtakingTime(right, left));
+        }
+        expiries[node] = expiry;
+    }
+
+    /**
+     * Recomputes the nodes below a node whose choice has expired
+     * @param node A node
+     */
+    void advanceNode(unsigned int node) {
+        if(expiries[node] > now) {
+            return;
+        }
+        advanceNode(2 * node);
+        advanceNode(2 * node + 1);
+        recompute(node);
+    }
+
+    /**
+     * Recomputes the ancestors of a leaf that changed
+     * @param leaf The leaf
+     */
+    void update(unsigned int leaf) {
+        for(unsigned int node = leaf / 2; node >= 1; node /= 2) {
+            recompute(node);
+        }
+    }
+
+    /**
+     * Recomputes every node from the leaves
+     */
+    void rebuild() {
+        for(int node = numLeaves - 1; node >= 1; node--) {
+            recompute(node);
+        }
+    }
+
+    /**
+     * Makes room for more processes, keeping the ones in the tree
+     * @param minLeaves The number of leaves needed
+     */
+    void grow(unsigned int minLeaves) {
+        unsigned int oldLeaves = numLeaves;
+        vector<int> oldWinners;
+        oldWinners.swap(winners);
+
+        numLeaves = max(2u, numLeaves);
+        while(numLeaves < minLeaves) {
+            numLeaves *= 2;
+        }
+        lines.resize(numLeaves);
+        winners.assign(2 * numLeaves, -1);
+        expiries.assign(2 * numLeaves, NEVER);
+        for(unsigned int i = 0; i < oldLeaves; i++) {
+            winners[numLeaves + i] = oldWinners[oldLeaves + i];
+        }
+        rebuild();
+    }
+
+};
+
+#endif //RESPONSE_RATIO_TREE_H
@@ -1,16 +1,16 @@
 #ifndef ROUND_ROBIN_H
 #define ROUND_ROBIN_H
 
-#include <deque>
 #include <iostream>
 #include <vector>
 
 #include "../scheduler.h"
-#include "../process.h"
+#include "../process_table.h"
+#include "ready_queue.h"
 
 using namespace std;
 
-int quantum = 10;
+inline int quantum = 10;  // the default time quantum, shared by every file that includes this header
 
 /**
  * Scheduler that implements the Round Robin (RR) algorithm
@@ -18,83 +18,219 @@ int quantum = 10;
  * Round Robin's functionality is split into two helper functions to make it compatible when used in
  * Multilevel scheduling and Multilevel Feedback scheduling
  */
-class RoundRobin: public Scheduler {
+class RoundRobin final : public Scheduler {
 
 public:
 
     int timeQuantum = 0;
-    int timeToNextSched = 0;
-    deque<int> readyProcesses;
+    int initialTimeToNextSched = 0;  // the time left in the quantum before the first process starts running
+    ReadyQueue readyProcesses;  // processes waiting for a CPU, in the order they will run
+    vector<int> heads;  // the process running on each CPU, or -1 if the CPU has none
+    vector<int> idleTimeToNextSched;  // the time left in the quantum of each CPU while it has no process
+    vector<int> sliceStart;  // each process's timeScheduled when its time quantum began, or -1 if it has none
 
     RoundRobin() {
         timeQuantum = quantum;
-        timeToNextSched = quantum;
+        initialTimeToNextSched = quantum;
     }
 
     RoundRobin(int quantum) {
         timeQuantum = quantum;
     }
 
+    RoundRobin(int quantum, int initialTimeToNextSched) {
+        timeQuantum = quantum;
+        this->initialTimeToNextSched = initialTimeToNextSched;
+    }
+
     /**
      * Chooses the next process that is ready and runs it for a set time quantum before moving to the next
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
+        return getNextProcess(0, processes);
+    }
 
-        int index = -1;
+    /**
+     * Runs Round Robin for one of several CPUs; each CPU has its own position in its own process's quantum
+     * @param cpu The CPU to choose a process for
+     * @param currentProcess The index of the process on that CPU, or -1 if the CPU is free
+     * @param currentTime The total time accumulated by the CPU so far
+     * @param processes The table of processes for the scheduler to choose from
+     * @return Index of the process in the list that should run on the CPU at the next time step
+     */
+    int runOnCpu(int cpu, int currentProcess, int currentTime, ProcessTable& processes) {
+        return getNextProcess(cpu, processes);
+    }
 
-        updateReadyProcesses(currentTime, processList);
-        index = getNextProcess(processList);
+    /**
+     * Skips ahead to the end of the current time quantum, since the process on the CPU keeps running until
+     * then unless a process arrives or finishes first
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for Round Robin to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return fastForwardOnCpu(0, currentProcess, currentTime, maxTicks, processes);
+    }
 
+    /**
+     * Skips ahead to the end of the time quantum of the process on one CPU
+     * @param cpu The CPU the choice was made for
+     * @param currentProcess The index returned by the last call to runOnCpu() for the CPU
+     * @param currentTime The time passed to the last call to runOnCpu()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for Round Robin to choose from
+     * @return The number of time steps that the choice from runOnCpu() holds for
+     */
+    int fastForwardOnCpu(int cpu, int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+
+        // an idle CPU stays idle until the next arrival
+        if(static_cast<unsigned int>(cpu) >= heads.size() || heads[cpu] < 0) {
+            return maxTicks;
+        }
+
+        // the quantum ends once the process has used all of it
+        return min(maxTicks, timeToNextSched(heads[cpu], processes));
+    }
+
+    /**
+     * Adds a newly arrived process to the back of the queue
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        if(sliceStart.size() < processes.size()) {
+            sliceStart.resize(processes.size(), -1);
+        }
+        readyProcesses.push_back(processIndex);
+    }
+
+    /**
+     * Gives away the process at the back of the queue, which would otherwise wait the longest
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        if(readyProcesses.empty()) {
+            return -1;
+        }
+        int index = readyProcesses.back();
+        readyProcesses.pop_back();
+        sliceStart[index] = -1;  // the process starts a new quantum wherever it runs next
         return index;
+    }
 
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    RoundRobin* clone() const {
+        return new RoundRobin(*this);
     }
 
     /**
-     * Helper function that updates the queue that tracks the order in which processes arrive at the CPU
-     * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for Round Robin to choose from
+     * Reports the single ready queue
+     * @param depths Set to the number of waiting processes
      */
-    void updateReadyProcesses(int currentTime, vector<Process*>& processList) {
-        for(int i = 0; i < processList.size(); i++) {
-            if(processList.at(i)->arrivalTime == currentTime) {
-                readyProcesses.push_back(i);
-            }
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(1, readyProcesses.size());
+    }
+
+    /**
+     * Helper function that takes the process off a CPU when a higher priority level runs on it instead
+     * The process goes back to the front of the queue and keeps what is left of its time quantum
+     * @param cpu The CPU to take the process off
+     * @param processes The table of processes
+     */
+    void releaseHead(int cpu, ProcessTable& processes) {
+
+        if(static_cast<unsigned int>(cpu) >= heads.size() || heads[cpu] < 0) {
+            return;
+        }
+
+        int index = heads[cpu];
+        heads[cpu] = -1;
+
+        if(!processes.isRunnable(index)) {
+            // the next process starts a full quantum, just as if the finished one had been rotated out
+            sliceStart[index] = -1;
+            idleTimeToNextSched[cpu] = timeQuantum;
+        } else {
+            readyProcesses.push_front(index);
         }
     }
 
     /**
-     * Helper function that determines the next process to run
-     * @param processList The list of processes for Round Robin to choose from
+     * Helper function that determines the next process to run on a CPU
+     * @param cpu The CPU to choose a process for
+     * @param processes The table of processes
      * @return Index of the process in the list that should run at the next time step
      */
-    int getNextProcess(vector<Process*>& processList) {
+    int getNextProcess(int cpu, ProcessTable& processes) {
 
-        int index = -1;
+        if(static_cast<unsigned int>(cpu) >= heads.size()) {
+            heads.resize(cpu + 1, -1);
+            idleTimeToNextSched.resize(cpu + 1, initialTimeToNextSched);
+        }
 
-        // Check if the end of the time quantum was reached or if the process finished
-        if(readyProcesses.size() > 0 && (timeToNextSched == 0 || processList[readyProcesses[0]]->isDone)) {
-            // If the time quantum is over but the process isn't done, push it to the back of the queue
-            if(!processList[readyProcesses[0]]->isDone) {
-                readyProcesses.push_back(readyProcesses[0]);
+        // the process that would run: the one already on the CPU, or else the one at the front of the queue
+        int first = heads[cpu] >= 0 ? heads[cpu] : (readyProcesses.empty() ? -1 : readyProcesses.front());
+
+        if(first >= 0) {
+            int timeLeft = sliceStart[first] >= 0 ? timeToNextSched(first, processes) : idleTimeToNextSched[cpu];
+
+            // Check if the end of the time quantum was reached or if the process finished or blocked on I/O
+            if(timeLeft == 0 || !processes.isRunnable(first)) {
+                if(heads[cpu] >= 0) {
+                    heads[cpu] = -1;
+                } else {
+                    readyProcesses.pop_front();
+                }
+                sliceStart[first] = -1;
+
+                // If the time quantum is over but the process can still run, push it to the back of the queue
+                if(processes.isRunnable(first)) {
+                    readyProcesses.push_back(first);
+                }
+
+                // move on to the next process in the queue, which starts a full time quantum
+                if(!readyProcesses.empty()) {
+                    heads[cpu] = readyProcesses.front();
+                    readyProcesses.pop_front();
+                    sliceStart[heads[cpu]] = processes.timeScheduled[heads[cpu]];
+                }
+            } else if(heads[cpu] < 0) {
+                // the process at the front of the queue takes the CPU, resuming its quantum if it has one
+                heads[cpu] = first;
+                readyProcesses.pop_front();
+                if(sliceStart[first] < 0) {
+                    sliceStart[first] = processes.timeScheduled[first];
+                }
             }
-
-            readyProcesses.pop_front();  // move on to the next process in the queue
-            timeToNextSched = timeQuantum;  // reset the time until the end of the next quantum
         }
 
-        if(readyProcesses.size() > 0) {
-            index = readyProcesses[0];  // the currently running process is at the head of the queue
-            timeToNextSched--;  // decrement the amount of time before the end of the current time quantum
-        } else {
-            index = -1;  // no process to run
-            timeToNextSched = 0;
+        if(heads[cpu] < 0) {
+            idleTimeToNextSched[cpu] = 0;  // no process to run
         }
 
-        return index;
+        return heads[cpu];
+    }
+
+private:
+
+    /**
+     * @param processIndex A process that has a time quantum
+     * @param processes The table of processes
+     * @return The number of time steps left in the process's time quantum
+     */
+    int timeToNextSched(int processIndex, ProcessTable& processes) const {
+        return timeQuantum - (processes.timeScheduled[processIndex] - sliceStart[processIndex]);
     }
 
 };
@@ -0,0 +1,343 @@
+#ifndef SCHEDULABILITY_ANALYSIS_H
+#define SCHEDULABILITY_ANALYSIS_H
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "../process_table.h"
+
+using namespace std;
+
+/**
+ * Analytical schedulability tests for a set of periodic realtime tasks on one CPU, answering whether Rate
+ * Monotonic (RM) or Earliest Deadline First (EDF) meets every deadline without simulating any jobs
+ * Each task is taken the same way as by --periodic: it needs its computation time every period, and must finish
+ * each job within the distance from its arrival to its deadline (its relative deadline)
+ * The exact tests assume every task may release a job at the same time (the critical instant), which is the
+ * worst case for any set of arrival times
+ * Time is measured as in the textbook tests: a job released at time r with a response time of R finishes at
+ * the end of time step r + R - 1, and meets its deadline if R is at most its relative deadline
+ */
+class SchedulabilityAnalysis {
+
+public:
+
+    /**
+     * Builds the task model, terminating the program if a task is not periodic
+     * @param tasks The table of realtime tasks
+     */
+    explicit SchedulabilityAnalysis(const ProcessTable& tasks) {
+
+        for(unsigned int i = 0; i < tasks.size(); i++) {
+            if(tasks.period[i] < 1 || tasks.totalTimeNeeded[i] < 1 || tasks.deadline[i] <= tasks.arrivalTime[i]) {
+                cerr << "Task \"" << tasks.getId(i) << "\" needs a positive computation time, period, and relative"
+                     << " deadline to be analyzed" << endl;
+                exit(-1);
+            }
+            computationTimes.push_back(tasks.totalTimeNeeded[i]);
+            periods.push_back(tasks.period[i]);
+            deadlines.push_back(static_cast<long long>(tasks.deadline[i]) - tasks.arrivalTime[i]);
+            totalUtilization += computationTimes[i] / static_cast<long double>(periods[i]);
+        }
+    }
+
+    /**
+     * @return The number of tasks
+     */
+    int size() const {
+        return computationTimes.size();
+    }
+
+    /**
+     * @return The fraction of the CPU the tasks need, the sum of their computation times over their periods
+     */
+    double utilization() const {
+        return totalUtilization;
+    }
+
+    /**
+     * @return Whether every relative deadline is at least its period, which the utilization bounds assume
+     */
+    bool deadlinesCoverPeriods() const {
+        for(int i = 0; i < size(); i++) {
+            if(deadlines[i] < periods[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @return The Liu and Layland utilization bound for RM, n(2^(1/n) - 1) for n tasks
+     */
+    double liuLaylandBound() const {
+        return size() == 0 ? 1 : size() * (pow(2.0, 1.0 / size()) - 1);
+    }
+
+    /**
+     * Sufficient test for RM: the tasks are schedulable if their utilization is within the Liu and Layland bound
+     * @return Whether the tasks pass the test
+     */
+    bool passesLiuLayland() const {
+        return deadlinesCoverPeriods() && totalUtilization <= liuLaylandBound() + TOLERANCE;
+    }
+
+    /**
+     * Sufficient test for RM that accepts more task sets than the Liu and Layland bound (Bini and Buttazzo):
+     * the tasks are schedulable if the product of one plus each task's utilization is at most 2
+     * @return Whether the tasks pass the test
+     */
+    bool passesHyperbolicBound() const {
+        long double product = 1;
+        for(int i = 0; i < size(); i++) {
+            product *= 1 + computationTimes[i] / static_cast<long double>(periods[i]);
+        }
+        return deadlinesCoverPeriods() && product <= 2 + TOLERANCE;
+    }
+
+    /**
+     * Exact test for RM by response-time analysis: each job's worst-case response time is the fixed point of its
+     * own computation time plus the interference from the jobs that take precedence over it, starting from the
+     * critical instant
+     * As in RateMonotonic, a job gives way to every task with a shorter period, and to jobs of tasks with the
+     * same period that were released before it, or at the same time by a task earlier in the table
+     * Every job of the task in the busy period that starts at the critical instant is checked, so the test is
+     * exact for relative deadlines longer than the periods as well
+     * @param responseTimes Filled with the worst-case response time of each task, or -1 if it misses a deadline
+     * @return Whether every task meets every deadline
+     */
+    bool rateMonotonicResponseTimes(vector<long long>& responseTimes) const {
+
+        vector<int> priorityOrder(size());
+        iota(priorityOrder.begin(), priorityOrder.end(), 0);
+        stable_sort(priorityOrder.begin(), priorityOrder.end(), [this](int a, int b) {
+            return periods[a] < periods[b];
+        });
+
+        // tasks with a period of at least a job's response time release one job during it, so their share of the
+        // interference comes from a running total instead of a term per task
+        vector<long long> orderedPeriods(size());
+        vector<long long> computationTotals(size() + 1, 0);
+        for(int position = 0; position < size(); position++) {
+            orderedPeriods[position] = periods[priorityOrder[position]];
+            computationTotals[position + 1] = computationTotals[position] + computationTimes[priorityOrder[position]];
+        }
+
+        responseTimes.assign(size(), -1);
+        bool schedulable = true;
+        int groupStart = 0;  // the first position in priority order with the task's period
+        int groupEnd = 0;  // the position after the last one with the task's period
+        long long previousFinish = 0;  // when the first job of the task before in priority order finishes
+
+        for(int position = 0; position < size(); position++) {
+            int task = priorityOrder[position];
+            if(position == groupEnd) {
+                groupStart = position;
+                while(groupEnd < size() && periods[priorityOrder[groupEnd]] == periods[task]) {
+                    groupEnd++;
+                }
+            }
+
+            long long worst = 0;
+            long long length = 0;  // the length of the busy period, or 0 until it is needed
+
+            // the CPU runs nothing but jobs that take precedence until the first job before this one finishes, so
+            // the iteration can start from there (Davis, Zabos and Burns)
+            long long finish = previousFinish + computationTimes[task];
+
+            for(long long job = 0; ; job++) {
+                long long release = job * periods[task];
+                long long limit = release + deadlines[task];  // the job misses its deadline past this time
+
+                // work from tasks with the same period that is due before the job, which is all released by then
+                long long demandBefore = (job + 1) * computationTimes[task];
+                for(int same = groupStart; same < groupEnd; same++) {
+                    if(same != position) {
+                        demandBefore += (same < position ? job + 1 : job) * computationTimes[priorityOrder[same]];
+                    }
+                }
+
+                // the time the job finishes if tasks with shorter periods keep releasing jobs from time 0
+                finish = max(finish, demandBefore);
+                while(finish <= limit) {
+                    int shorter = lower_bound(orderedPeriods.begin(), orderedPeriods.begin() + groupStart, finish)
+                                  - orderedPeriods.begin();
+                    long long demand = demandBefore + computationTotals[groupStart] - computationTotals[shorter];
+                    for(int higher = 0; higher < shorter && demand <= limit; higher++) {
+                        int other = priorityOrder[higher];
+                        demand += (finish + periods[other] - 1) / periods[other] * computationTimes[other];
+                    }
+                    if(demand == finish) {
+                        break;
+                    }
+                    finish = demand;
+                }
+
+                if(finish > limit) {
+                    worst = -1;
+                    break;
+                }
+                if(job == 0) {
+                    previousFinish = finish;
+                }
+                worst = max(worst, finish - release);
+
+                // stop once the CPU catches up with the task's period and shorter ones, which ends the busy period
+                if(releasedWork(priorityOrder, groupEnd, finish) == finish) {
+                    break;
+                }
+                if(length == 0) {
+                    length = busyPeriod(priorityOrder, groupEnd);
+                }
+                if(length >= 0 && release + periods[task] >= length) {
+                    break;
+                }
+            }
+
+            responseTimes[task] = worst;
+            schedulable = schedulable && worst >= 0;
+        }
+
+        return schedulable;
+    }
+
+    /**
+     * Exact test for EDF by processor demand: the tasks are schedulable if their utilization is at most 1 and,
+     * at every absolute deadline up to the length of the synchronous busy period, the computation time of the
+     * jobs due by then fits before it
+     * The deadlines are visited with Quick convergence Processor-demand Analysis (QPA, Zhang and Burns), which
+     * steps backwards from the last one and jumps straight to the demand, so few of them are evaluated
+     * When every deadline is at least its period, the utilization condition alone is exact
+     * @return Whether every task meets every deadline
+     */
+    bool earliestDeadlineFirstDemand() const {
+
+        if(totalUtilization > 1 + TOLERANCE) {
+            return false;
+        } else if(size() == 0 || deadlinesCoverPeriods()) {
+            return true;
+        }
+
+        vector<int> allTasks(size());
+        iota(allTasks.begin(), allTasks.end(), 0);
+        long long length = busyPeriod(allTasks, size());
+        if(length < 0) {
+            return false;  // the busy period never ends, so the CPU is overloaded
+        }
+
+        // with utilization below 1, no deadline after La (Zhang and Burns) can be missed either
+        if(totalUtilization < 1 - TOLERANCE) {
+            long double boundary = 0;
+            long long longestSlack = LLONG_MIN;
+            for(int i = 0; i < size(); i++) {
+                boundary += (periods[i] - deadlines[i]) * (computationTimes[i] / static_cast<long double>(periods[i]));
+                longestSlack = max(longestSlack, deadlines[i] - periods[i]);
+            }
+            boundary = max<long double>(ceill(boundary / (1 - totalUtilization)) + 1, longestSlack);
+            if(boundary < length) {
+                length = boundary;
+            }
+        }
+
+        long long shortestDeadline = *min_element(deadlines.begin(), deadlines.end());
+        long long time = lastDeadlineBefore(length + 1);
+        long long demand = time < 0 ? 0 : demandBound(time);
+
+        while(demand <= time && demand > shortestDeadline) {
+            time = demand < time ? demand : lastDeadlineBefore(time);
+            demand = demandBound(time);
+        }
+
+        return demand <= shortestDeadline;
+    }
+
+private:
+
+    static constexpr long double TOLERANCE = 1e-12;  // rounding allowance when comparing utilizations
+
+    vector<long long> computationTimes;  // the computation time of each task's jobs
+    vector<long long> periods;  // the time between each task's releases
+    vector<long long> deadlines;  // the time each job has from its release to finish
+    long double totalUtilization = 0;  // the sum of every task's computation time over its period
+
+    /**
+     * @param time A length of time from the critical instant
+     * @return The computation time of the jobs that are released and due within that time
+     */
+    long long demandBound(long long time) const {
+        long long demand = 0;
+        for(int i = 0; i < size(); i++) {
+            if(deadlines[i] <= time) {
+                demand += ((time - deadlines[i]) / periods[i] + 1) * computationTimes[i];
+            }
+        }
+        return demand;
+    }
+
+    /**
+     * @param time A length of time from the critical instant
+     * @return The latest absolute deadline of any job that is strictly before that time, or -1 if there is none
+     */
+    long long lastDeadlineBefore(long long time) const {
+        long long latest = -1;
+        for(int i = 0; i < size(); i++) {
+            if(deadlines[i] < time) {
+                latest = max(latest, deadlines[i] + (time - 1 - deadlines[i]) / periods[i] * periods[i]);
+            }
+        }
+        return latest;
+    }
+
+    /**
+     * @param tasks A list of task indices
+     * @param count The number of tasks at the start of the list to count
+     * @param time A length of time from the critical instant
+     * @return The computation time of the jobs those tasks release before that time
+     */
+    long long releasedWork(const vector<int>& tasks, int count, long long time) const {
+        long long work = 0;
+        for(int position = 0; position < count; position++) {
+            int task = tasks[position];
+            work += (time + periods[task] - 1) / periods[task] * computationTimes[task];
+        }
+        return work;
+    }
+
+    /**
+     * Computes how long the CPU stays busy when some of the tasks release a job at once and the rest never run,
+     * which is at most their hyperperiod unless they overload the CPU
+     * @param tasks A list of task indices
+     * @param count The number of tasks at the start of the list to count
+     * @return The length of the busy period, or -1 if it grows past the hyperperiod
+     */
+    long long busyPeriod(const vector<int>& tasks, int count) const {
+
+        long long limit = 1;
+        for(int position = 0; position < count && limit < LLONG_MAX; position++) {
+            long long period = periods[tasks[position]];
+            long long divisor = gcd(limit, period);
+            limit = limit / divisor > LLONG_MAX / period ? LLONG_MAX : limit / divisor * period;
+        }
+
+        long long length = 0;
+        for(int position = 0; position < count; position++) {
+            length += computationTimes[tasks[position]];
+        }
+
+        while(length <= limit) {
+            long long work = releasedWork(tasks, count, length);
+            if(work == length) {
+                return length;
+            }
+            length = work;
+        }
+        return -1;
+    }
+
+};
+
+#endif //SCHEDULABILITY_ANALYSIS_H
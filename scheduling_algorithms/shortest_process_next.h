@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "../scheduler.h"
+#include "ready_heap.h"
 
 using namespace std;
 
@@ -11,45 +12,82 @@ using namespace std;
  * Scheduler that implements the Shortest Process Next (SPN) algorithm
  * SPN is a non-preemptive scheduling algorithm
  */
-class ShortestProcessNext: public Scheduler {
+class ShortestProcessNext final : public Scheduler {
 
 public:
 
+    ReadyHeap readyProcesses;  // arrived processes that have not run yet
+
     /**
      * Chooses the process with the shortest required computation time
+     * Arrived processes wait in a heap keyed on their computation time, so a choice takes O(log n)
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
 
         int index = currentProcess;
 
         // SPN is a non-preemptive algorithm, so do not choose a new process unless
-        // there is no currently running process or the current process just finished
-        if(currentProcess < 0 || processList.at(currentProcess)->isDone) {
-
-            int minTime = INFINITY;
-            for(int i = 0; i < processList.size(); i++) {
-
-                // only consider processes that have arrived at the CPU
-                if(processList.at(i)->hasArrived) {
-                    // only consider processes that are not done
-                    if(!processList.at(i)->isDone) {
-                        int totalTimeNeeded = processList.at(i)->totalTimeNeeded;
-                        if(totalTimeNeeded < minTime) {
-                            index = i;  // select this process
-                            minTime = totalTimeNeeded;  // set the new minimum
-                        }
-                    }
-                }
+        // there is no currently running process or the current process just finished or blocked on I/O
+        if(currentProcess < 0 || !processes.isRunnable(currentProcess)) {
+            // the process with the shortest computation time is at the top of the heap
+            if(!readyProcesses.empty()) {
+                index = readyProcesses.pop();
             }
         }
 
         return index;
     }
 
+    /**
+     * Gives away the waiting process that would run next
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        return readyProcesses.empty() ? -1 : readyProcesses.pop();
+    }
+
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    ShortestProcessNext* clone() const {
+        return new ShortestProcessNext(*this);
+    }
+
+    /**
+     * Reports the single ready queue
+     * @param depths Set to the number of waiting processes
+     */
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(1, readyProcesses.size());
+    }
+
+    /**
+     * Adds a newly arrived process to the ready heap, keyed on its required computation time
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        readyProcesses.push(processes.totalTimeNeeded[processIndex], processIndex);
+    }
+
+    /**
+     * SPN is non-preemptive, so its choice only changes when a process arrives or the current process finishes
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return maxTicks;
+    }
+
 };
 
 #endif //SHORTEST_PROCESS_NEXT_H
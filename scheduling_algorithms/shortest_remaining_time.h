@@ -2,46 +2,94 @@
 #define SHORTEST_REMAINING_TIME_H
 
 #include "../scheduler.h"
+#include "ready_heap.h"
 
 /**
  * Scheduler that implements the Shortest Remaining Time (SRT) algorithm
  * SRT is a preemptive scheduling algorithm
  */
-class ShortestRemainingTime: public Scheduler {
+class ShortestRemainingTime final : public Scheduler {
 
 public:
 
+    ReadyHeap readyProcesses;  // processes that are waiting to run
+
     /**
      * Chooses the process with the least amount of time left to compute
+     * Processes that are waiting to run are kept in a heap keyed on their remaining time, while the running
+     * process stays out of the heap, since its remaining time changes as it runs
      * @param currentProcess The index of the current process, or -1 if the CPU is free
      * @param currentTime The total time accumulated by the CPU so far
-     * @param processList The list of processes for the scheduler to choose from
+     * @param processes The table of processes for the scheduler to choose from
      * @return Index of the process in the list that should run at the next time step
      */
-    int run(int currentProcess, int currentTime, vector<Process*>& processList) {
+    int run(int currentProcess, int currentTime, ProcessTable& processes) {
 
         int index = currentProcess;
 
-        // SRT is a preemptive algorithm; no need to check if a process is already running
-        int minTime = INFINITY;
-        for(int i = 0; i < processList.size(); i++) {
-            // only consider processes that have arrived at the CPU
-            if(processList.at(i)->hasArrived) {
-                // only consider processes that are not done
-                if (!processList.at(i)->isDone) {
-                    // compute the remaining time for this process: total time needed - time scheduled
-                    int remainingTime = processList.at(i)->totalTimeNeeded - processList.at(i)->timeScheduled;
-                    if (remainingTime < minTime) {
-                        index = i;  // select the process
-                        minTime = remainingTime;  // set the new minimum
-                    }
-                }
+        if(currentProcess >= 0 && processes.isRunnable(currentProcess)) {
+            // SRT is a preemptive algorithm; the current process keeps running unless a waiting process has less time left
+            // compute the remaining time for this process: total time needed - time scheduled
+            int remainingTime = processes.remainingTime(currentProcess);
+            if(readyProcesses.topPrecedes(remainingTime, currentProcess)) {
+                index = readyProcesses.pop();  // select the waiting process
+                readyProcesses.push(remainingTime, currentProcess);  // the preempted process waits again
             }
+        } else if(!readyProcesses.empty()) {
+            // otherwise, select the waiting process with the least time left
+            index = readyProcesses.pop();
         }
 
         return index;
     }
 
+    /**
+     * Gives away the waiting process that would run next
+     * @param currentTime The current time
+     * @param processes The table of processes
+     * @return The index of the removed process, or -1 if no process is waiting
+     */
+    int steal(int currentTime, ProcessTable& processes) {
+        return readyProcesses.empty() ? -1 : readyProcesses.pop();
+    }
+
+    /**
+     * @return A copy of the scheduler in its current state, for continuing a simulation from a snapshot
+     */
+    ShortestRemainingTime* clone() const {
+        return new ShortestRemainingTime(*this);
+    }
+
+    /**
+     * Reports the single ready queue
+     * @param depths Set to the number of waiting processes
+     */
+    void queueDepths(vector<int>& depths) const {
+        depths.assign(1, readyProcesses.size());
+    }
+
+    /**
+     * Adds a newly arrived process to the ready heap, keyed on its remaining time
+     * @param processIndex The index of the process that arrived
+     * @param processes The table of processes
+     */
+    void processArrived(int processIndex, ProcessTable& processes) {
+        int remainingTime = processes.remainingTime(processIndex);
+        readyProcesses.push(remainingTime, processIndex);
+    }
+
+    /**
+     * Running a process only shrinks its remaining time, so SRT keeps its choice until a process arrives or finishes
+     * @param currentProcess The index returned by the last call to run()
+     * @param currentTime The time passed to the last call to run()
+     * @param maxTicks The number of time steps until the next arrival or completion
+     * @param processes The table of processes for the scheduler to choose from
+     * @return The number of time steps that the choice from run() holds for
+     */
+    int fastForward(int currentProcess, int currentTime, int maxTicks, ProcessTable& processes) {
+        return maxTicks;
+    }
+
 };
 
 #endif //SHORTEST_REMAINING_TIME_H
@@ -0,0 +1,663 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "arrival_calendar.h"
+#include "burst_model.h"
+#include "event_counters.h"
+#include "process_table.h"
+#include "run_metrics.h"
+#include "scheduler.h"
+
+using namespace std;
+
+/**
+ * How the CPUs of a multi-core simulation share the processes that are ready to run
+ */
+enum QueueMode {
+    GLOBAL_QUEUE,  // every CPU takes processes from a single scheduler
+    PER_CPU_QUEUES  // each CPU has its own scheduler, and idle CPUs steal from the busiest one
+};
+
+/**
+ * Data structure describing what one CPU did during a time slice
+ */
+struct CpuSlice {
+    int processIndex = -1;  // the process that ran on the CPU, or -1 if the CPU was idle
+    bool finished = false;  // whether the process finished on the last time step of the slice
+    bool overran = false;  // whether the process was already done and ran past its required computation time (only
+                           // with keepOverruns)
+    bool migrated = false;  // whether the process last ran on a different CPU
+    bool blocked = false;  // whether the process left the CPU to wait for I/O at the end of the slice
+};
+
+/**
+ * Data structure describing a stretch of consecutive time steps during which every CPU made the same choice
+ */
+struct TimeSlice {
+    int startTime = 0;  // the first time step of the slice
+    int duration = 0;  // the number of time steps in the slice
+    vector<CpuSlice> cpus;  // what each CPU did during the slice
+};
+
+/**
+ * The state of a simulation between two steps, from which it can be continued any number of times
+ * Taken by BasicSimulator::snapshot() and continued by constructing a BasicSimulator from it: with the schedulers
+ * from copySchedulers() the continuation picks up exactly where the simulation left off, and with new schedulers
+ * and handOverProcesses() a different scheduling algorithm takes over from the same point
+ * The prefix up to the snapshot is only simulated once however many branches continue from it, and only the
+ * state that changes as a simulation runs is copied; the arrival calendar is shared, and each branch restores
+ * the changing columns of the process table (time scheduled, finish time, and flags) into a table that holds the
+ * same processes, so one table can be reused by branches run one after another
+ */
+class SimulationSnapshot {
+
+public:
+
+    /**
+     * @return The time the simulation had reached
+     */
+    int getTime() const {
+        return currentTime;
+    }
+
+    /**
+     * @return Whether every process had finished computing
+     */
+    bool isComplete() const {
+        return complete;
+    }
+
+    /**
+     * @return Copies of the schedulers in the state they were in, which the caller deletes
+     */
+    vector<Scheduler*> copySchedulers() const {
+        vector<Scheduler*> copies;
+        for(const shared_ptr<const Scheduler>& scheduler : schedulers) {
+            copies.push_back(scheduler->clone());
+        }
+        return copies;
+    }
+
+private:
+
+    friend class SimulatorBase;
+    template<class SchedulerType> friend class BasicSimulator;
+
+    int numCpus = 1;  // the number of CPUs
+    QueueMode queueMode = GLOBAL_QUEUE;  // how the CPUs share the processes that are ready to run
+    shared_ptr<const ArrivalCalendar> arrivals;  // the processes in order of arrival, shared with the simulation
+    unsigned int nextArrival = 0;  // position in the arrival calendar of the next process to arrive
+    unsigned int processesRemaining = 0;  // the number of processes that are not done
+    vector<int> running;  // the process chosen for each CPU
+    vector<int> busyTime;  // the number of time steps each CPU ran a process
+    vector<int> queueLength;  // the number of unfinished processes in each CPU's run queue (PER_CPU_QUEUES)
+    vector<int> owner;  // the CPU whose run queue holds each process (PER_CPU_QUEUES)
+    vector<int> lastCpu;  // the CPU each process last ran on, or -1 if it has not run
+    int migrations = 0;  // the number of times a process moved to a different CPU
+    EventCounters events;  // the operational counters
+    RunMetrics metrics;  // the metrics of the processes that have run or finished
+    int currentTime = 0;  // the time of the next step
+    int timesIdle = 0;  // the number of time steps when a CPU was idle
+    bool complete = false;  // whether every process had finished
+    vector<int> timeScheduled;  // the time each process had run for
+    vector<int> timeFinished;  // the time each process finished, or -1
+    vector<unsigned char> flags;  // the ARRIVED and DONE flags of each process
+    vector<shared_ptr<const Scheduler>> schedulers;  // copies of the schedulers, kept unchanged
+
+};
+
+/**
+ * State and results of a discrete-event simulation, shared by every BasicSimulator whatever its scheduler type
+ * Code that only reads the results of a simulation takes a SimulatorBase, so it works with any of them
+ */
+class SimulatorBase {
+
+public:
+
+    /**
+     * @return Whether every process has finished computing
+     */
+    bool isComplete() const {
+        return complete;
+    }
+
+    /**
+     * @return The current time, or the time of the last time step once the simulation is complete
+     */
+    int getCurrentTime() const {
+        return currentTime;
+    }
+
+    /**
+     * @return The number of time steps when a CPU was idle, summed over every CPU
+     */
+    int getTimesIdle() const {
+        return timesIdle;
+    }
+
+    /**
+     * @return The number of simulated CPUs
+     */
+    int getNumCpus() const {
+        return numCpus;
+    }
+
+    /**
+     * @param cpu The CPU, counting from 0
+     * @return The number of time steps when the CPU was running a process
+     */
+    int getBusyTime(int cpu) const {
+        return busyTime[cpu];
+    }
+
+    /**
+     * @return The number of times a process started running on a different CPU from the one it last ran on
+     */
+    int getMigrations() const {
+        return migrations;
+    }
+
+    /**
+     * @return The distributions of turnaround, waiting, and response times of the processes so far
+     */
+    const RunMetrics& getMetrics() const {
+        return metrics;
+    }
+
+    /**
+     * @return The context switch, preemption, queue depth, and waiting counters (only kept with SCHEDULER_COUNTERS)
+     */
+    const EventCounters& getEvents() const {
+        return events;
+    }
+
+    /**
+     * Makes the processes alternate CPU and I/O bursts, as their behaviors in the model yield them, instead of
+     * each computing in one burst; must be called before the first step
+     * @param model The burst model, which the caller keeps alive for as long as the simulation runs
+     */
+    void setBurstModel(BurstModel* model) {
+        bursts = model;
+    }
+
+    /**
+     * Keeps a finished process that a scheduler hands back (for lack of another) on its CPU, running past its
+     * computation time, as the interactive table has always shown it; by default the CPU is idle instead
+     * @param keep Whether to keep the finished process on the CPU
+     */
+    void setKeepOverruns(bool keep) {
+        keepOverruns = keep;
+    }
+
+    /**
+     * @return The burst model of the simulation, or nullptr if each process computes in one burst
+     */
+    const BurstModel* getBurstModel() const {
+        return bursts;
+    }
+
+    /**
+     * Samples the depths of the ready queues as the simulation runs (only with SCHEDULER_COUNTERS)
+     * @param interval The number of time steps between samples
+     */
+    void sampleQueueDepths(int interval) {
+        events.setSampleInterval(interval);
+    }
+
+protected:
+
+    /**
+     * Sets up the state of a simulation, terminating the program if the CPUs and schedulers do not match
+     * @param processes The table of processes to simulate
+     * @param numCpus The number of CPUs
+     * @param queueMode How the CPUs share the processes that are ready to run
+     * @param numSchedulers The number of schedulers: one for GLOBAL_QUEUE, or one per CPU for PER_CPU_QUEUES
+     * @param arrivals The arrival calendar of the processes, or nullptr to build one
+     */
+    SimulatorBase(ProcessTable& processes, int numCpus, QueueMode queueMode, unsigned int numSchedulers,
+                  shared_ptr<const ArrivalCalendar> arrivals)
+        : processes(processes), numCpus(numCpus), queueMode(queueMode), arrivals(arrivals) {
+
+        if(numCpus < 1 || numSchedulers != (queueMode == GLOBAL_QUEUE ? 1u : static_cast<unsigned int>(numCpus))) {
+            cerr << "A simulation needs at least one CPU and a scheduler for every run queue" << endl;
+            exit(-1);
+        }
+
+        // Order the processes by arrival time once so that arrivals can be found without scanning the list
+        if(!this->arrivals) {
+            this->arrivals = make_shared<ArrivalCalendar>(processes);
+        }
+
+        processesRemaining = processes.size();
+        running.assign(numCpus, -1);
+        busyTime.assign(numCpus, 0);
+        queueLength.assign(numCpus, 0);
+        lastCpu.assign(processes.size(), -1);
+        if(queueMode == PER_CPU_QUEUES) {
+            owner.assign(processes.size(), -1);
+        }
+        events.start(processes.size(), numCpus);
+    }
+
+    /**
+     * Restores the state of a simulation from a snapshot, terminating the program if the process table or the
+     * schedulers do not match it
+     * @param snapshot The snapshot to continue from
+     * @param processes A table holding the same processes as the snapshotted simulation, in any state
+     * @param numSchedulers The number of schedulers the simulation continues with
+     */
+    SimulatorBase(const SimulationSnapshot& snapshot, ProcessTable& processes, unsigned int numSchedulers)
+        : processes(processes), numCpus(snapshot.numCpus), queueMode(snapshot.queueMode), arrivals(snapshot.arrivals),
+          nextArrival(snapshot.nextArrival), processesRemaining(snapshot.processesRemaining), running(snapshot.running),
+          busyTime(snapshot.busyTime), queueLength(snapshot.queueLength), owner(snapshot.owner),
+          lastCpu(snapshot.lastCpu), migrations(snapshot.migrations), events(snapshot.events),
+          metrics(snapshot.metrics), currentTime(snapshot.currentTime), timesIdle(snapshot.timesIdle),
+          complete(snapshot.complete) {
+
+        if(processes.size() != snapshot.timeScheduled.size() || numSchedulers != snapshot.schedulers.size()) {
+            cerr << "A simulation can only continue from a snapshot of the same processes and number of schedulers" << endl;
+            exit(-1);
+        }
+
+        processes.timeScheduled = snapshot.timeScheduled;
+        processes.timeFinished = snapshot.timeFinished;
+        processes.flags = snapshot.flags;
+    }
+
+    /**
+     * Copies the state of the simulation, apart from the schedulers, into a snapshot
+     * @param snapshot The snapshot to fill
+     */
+    void saveState(SimulationSnapshot& snapshot) const {
+        snapshot.numCpus = numCpus;
+        snapshot.queueMode = queueMode;
+        snapshot.arrivals = arrivals;
+        snapshot.nextArrival = nextArrival;
+        snapshot.processesRemaining = processesRemaining;
+        snapshot.running = running;
+        snapshot.busyTime = busyTime;
+        snapshot.queueLength = queueLength;
+        snapshot.owner = owner;
+        snapshot.lastCpu = lastCpu;
+        snapshot.migrations = migrations;
+        snapshot.events = events;
+        snapshot.metrics = metrics;
+        snapshot.currentTime = currentTime;
+        snapshot.timesIdle = timesIdle;
+        snapshot.complete = complete;
+        snapshot.timeScheduled = processes.timeScheduled;
+        snapshot.timeFinished = processes.timeFinished;
+        snapshot.flags = processes.flags;
+    }
+
+    ProcessTable& processes;  // the processes being simulated
+    int numCpus = 1;  // the number of CPUs
+    QueueMode queueMode = GLOBAL_QUEUE;  // how the CPUs share the processes that are ready to run
+    shared_ptr<const ArrivalCalendar> arrivals;  // the processes in order of arrival
+    unsigned int nextArrival = 0;  // position in the arrival calendar of the next process to arrive
+    unsigned int processesRemaining = 0;  // the number of processes that are not done
+    vector<int> running;  // the process chosen for each CPU, starting with none
+    vector<int> busyTime;  // the number of time steps each CPU ran a process
+    vector<int> queueLength;  // the number of unfinished processes in each CPU's run queue (PER_CPU_QUEUES)
+    vector<int> owner;  // the CPU whose run queue holds each process (PER_CPU_QUEUES)
+    vector<int> lastCpu;  // the CPU each process last ran on, or -1 if it has not run
+    int migrations = 0;  // the number of times a process moved to a different CPU
+    EventCounters events;  // the operational counters, reported to on every decision point
+    RunMetrics metrics;  // the metrics of every process, recorded as it first runs and as it finishes
+    int currentTime = 0;  // start out with a CPU time of 0
+    int timesIdle = 0;  // counter for the number of time steps when a CPU was idle
+    bool complete = false;  // flag for when CPU can quit
+    TimeSlice slice;  // the slice simulated by the last step
+    BurstModel* bursts = nullptr;  // the CPU and I/O bursts of the processes, or nullptr if each computes in one burst
+    bool keepOverruns = false;  // whether a finished process a scheduler hands back stays on the CPU instead of idling it
+
+    /**
+     * @param processIndex A process chosen by a scheduler
+     * @return Whether the process can do useful work, rather than the CPU being free or holding a finished or
+     *         blocked process
+     */
+    bool isRunning(int processIndex) const {
+        return processIndex >= 0 && static_cast<unsigned int>(processIndex) < processes.size() && processes.isRunnable(processIndex);
+    }
+
+};
+
+/**
+ * Discrete-event simulation engine
+ * Instead of calling the scheduler on every time step, the simulator asks the scheduler how long its choice
+ * holds and jumps straight to the next decision point (an arrival, a completion, or a scheduler-specific
+ * event such as the end of a time quantum; with a burst model, also the end of a CPU burst or of an I/O request)
+ * The results are identical to calling the scheduler once per time step
+ * Several CPUs can be simulated, either sharing one scheduler or each with a scheduler of its own
+ * The loop is compiled once per scheduler type: with a concrete (final) scheduler class the calls to the
+ * scheduler are resolved at compile time and inlined into step(), while Simulator (BasicSimulator<Scheduler>)
+ * goes through the virtual methods and works with any scheduler
+ */
+template<class SchedulerType>
+class BasicSimulator : public SimulatorBase {
+
+public:
+
+    /**
+     * Constructor for a simulation run on a single CPU
+     * @param scheduler The scheduling algorithm to simulate
+     * @param processes The table of processes to simulate
+     */
+    BasicSimulator(SchedulerType* scheduler, ProcessTable& processes)
+        : BasicSimulator(vector<SchedulerType*>{scheduler}, processes, 1, GLOBAL_QUEUE) {}
+
+    /**
+     * Constructor for a simulation run on several CPUs
+     * @param schedulers The scheduling algorithm shared by every CPU (GLOBAL_QUEUE), or one per CPU (PER_CPU_QUEUES)
+     * @param processes The table of processes to simulate
+     * @param numCpus The number of CPUs
+     * @param queueMode How the CPUs share the processes that are ready to run
+     * @param arrivals The arrival calendar of the processes, or nullptr to build one
+     */
+    BasicSimulator(const vector<SchedulerType*>& schedulers, ProcessTable& processes, int numCpus, QueueMode queueMode,
+                   shared_ptr<const ArrivalCalendar> arrivals = nullptr)
+        : SimulatorBase(processes, numCpus, queueMode, schedulers.size(), arrivals), schedulers(schedulers) {}
+
+    /**
+     * Constructor for a simulation that continues from a snapshot
+     * @param snapshot The snapshot to continue from
+     * @param schedulers The schedulers to continue with: the snapshot's copySchedulers() to carry on exactly as the
+     *                   snapshotted simulation would have, or new ones followed by a call to handOverProcesses()
+     * @param processes A table holding the same processes as the snapshotted simulation, whose state is replaced
+     */
+    BasicSimulator(const SimulationSnapshot& snapshot, const vector<SchedulerType*>& schedulers, ProcessTable& processes)
+        : SimulatorBase(snapshot, processes, schedulers.size()), schedulers(schedulers) {}
+
+    /**
+     * Takes a snapshot of the simulation between two steps, copying the state of every scheduler, terminating the
+     * program if the simulation has a burst model, whose suspended coroutines cannot be copied
+     * @return The snapshot
+     */
+    SimulationSnapshot snapshot() const {
+        if(bursts) {
+            cerr << "A simulation with CPU and I/O bursts cannot be snapshotted" << endl;
+            exit(-1);
+        }
+        SimulationSnapshot snapshot;
+        saveState(snapshot);
+        for(SchedulerType* scheduler : schedulers) {
+            snapshot.schedulers.push_back(shared_ptr<const Scheduler>(scheduler->clone()));
+        }
+        return snapshot;
+    }
+
+    /**
+     * Gives every process that has arrived and not finished to the schedulers, in order of arrival, as if it had
+     * just arrived, and takes the running processes off their CPUs so that the schedulers choose again
+     * Used when a simulation continues from a snapshot with schedulers that did not come from it, so that a
+     * different scheduling algorithm takes over from the same point; with PER_CPU_QUEUES each process stays in the
+     * run queue of the same CPU
+     */
+    void handOverProcesses() {
+        running.assign(numCpus, -1);
+        for(unsigned int position = 0; position < nextArrival; position++) {
+            int processIndex = arrivals->processAt(position);
+            if(processes.isDone(processIndex)) {
+                continue;
+            }
+            if(queueMode == GLOBAL_QUEUE) {
+                schedulers[0]->processArrived(processIndex, processes);
+            } else {
+                schedulers[owner[processIndex]]->processArrived(processIndex, processes);
+            }
+        }
+    }
+
+    /**
+     * Runs the simulation up to the next decision point
+     * The slice is kept by the simulator and reused, so stepping does not allocate memory
+     * @param stopTime A time the slice does not run past, so that the simulation can be paused exactly there (for
+     *                 example to take a snapshot); by default the slice runs to the next decision point
+     * @return The slice of time steps that were simulated, which is only valid until the next step
+     */
+    const TimeSlice& step(int stopTime = INT_MAX) {
+
+        slice.startTime = currentTime;
+        slice.cpus.assign(numCpus, CpuSlice());
+
+        // Processes whose I/O has completed are ready to run again, and go back to the schedulers
+        if(bursts) {
+            for(int processIndex = bursts->wake(currentTime, processes); processIndex >= 0;
+                processIndex = bursts->wake(currentTime, processes)) {
+                events.processArrived(processIndex, currentTime);
+                enqueue(processIndex);
+            }
+        }
+
+        // Update whether processes have arrived at the CPU based on the current time
+        while(nextArrival < arrivals->size() && arrivals->timeAt(nextArrival) == currentTime) {
+            int processIndex = arrivals->processAt(nextArrival);
+            processes.markArrived(processIndex);
+            events.processArrived(processIndex, currentTime);
+            if(!bursts || bursts->processArrived(processIndex, currentTime, processes)) {
+                enqueue(processIndex);
+            }
+            nextArrival++;
+        }
+
+        // Run the selected scheduling algorithm on every CPU at the current time
+        if(queueMode == GLOBAL_QUEUE) {
+            // CPUs without a process choose first, so that a newly arrived process goes to a free CPU
+            // instead of preempting a running one
+            for(int pass = 0; pass < 2; pass++) {
+                for(int cpu = 0; cpu < numCpus; cpu++) {
+                    if(isRunning(running[cpu]) == (pass == 1)) {
+                        running[cpu] = runOnCpu(schedulers[0], cpu, running[cpu], currentTime, processes);
+                    }
+                }
+            }
+        } else {
+            for(int cpu = 0; cpu < numCpus; cpu++) {
+                running[cpu] = schedulers[cpu]->run(running[cpu], currentTime, processes);
+                if(!isRunning(running[cpu]) && stealFor(cpu)) {
+                    running[cpu] = schedulers[cpu]->run(running[cpu], currentTime, processes);
+                }
+            }
+        }
+
+        // A scheduler with nothing else to run can hand back a finished or blocked process, which leaves the CPU
+        // idle: it is not busy, the process does not migrate, and its time scheduled does not grow
+        for(int cpu = 0; cpu < numCpus; cpu++) {
+            int processIndex = running[cpu];
+            if(processIndex >= 0 && static_cast<unsigned int>(processIndex) < processes.size()
+                    && !processes.isRunnable(processIndex) && !(keepOverruns && processes.isDone(processIndex))) {
+                running[cpu] = -1;
+            }
+        }
+
+        // Nothing can change before the next arrival, before an I/O completes, or before a running process
+        // finishes or ends its CPU burst
+        int maxTicks = INT_MAX;
+        if(nextArrival < arrivals->size()) {
+            maxTicks = arrivals->timeAt(nextArrival) - currentTime;
+        }
+        if(bursts && bursts->nextCompletion() < INT_MAX) {
+            maxTicks = min(maxTicks, bursts->nextCompletion() - currentTime);
+        }
+        for(int cpu = 0; cpu < numCpus; cpu++) {
+            if(isRunning(running[cpu])) {
+                int remainingTime = bursts ? bursts->cpuTimeLeft(running[cpu], processes)
+                                           : processes.remainingTime(running[cpu]);
+                if(remainingTime > 0) {
+                    maxTicks = min(maxTicks, remainingTime);
+                }
+            }
+        }
+
+        if(maxTicks == INT_MAX) {
+            if(processesRemaining > 0) {
+                cerr << "Simulation cannot make progress at time " << currentTime
+                     << ": no processes are left to arrive or run" << endl;
+                exit(-1);
+            }
+            maxTicks = 1;  // nothing left to simulate
+        }
+
+        // Let the schedulers skip the time steps where every CPU's choice stays the same
+        int ticks = maxTicks;
+        for(int cpu = 0; cpu < numCpus; cpu++) {
+            if(queueMode == GLOBAL_QUEUE) {
+                ticks = min(ticks, fastForwardOnCpu(schedulers[0], cpu, running[cpu], currentTime, maxTicks, processes));
+            } else {
+                ticks = min(ticks, schedulers[cpu]->fastForward(running[cpu], currentTime, maxTicks, processes));
+            }
+        }
+        if(stopTime > currentTime) {
+            ticks = min(ticks, stopTime - currentTime);  // a shorter slice gives the same results, only in more steps
+        }
+        ticks = max(1, ticks);
+
+        slice.duration = ticks;
+        events.recordStep(currentTime, ticks, running, schedulers, processes);
+
+        for(int cpu = 0; cpu < numCpus; cpu++) {
+            int processIndex = running[cpu];
+            CpuSlice& cpuSlice = slice.cpus[cpu];
+
+            // If the returned index is valid, then update its member variables accordingly
+            if(processIndex >= 0 && static_cast<unsigned int>(processIndex) < processes.size()) {
+                cpuSlice.processIndex = processIndex;
+                cpuSlice.overran = processes.isDone(processIndex);
+                if(lastCpu[processIndex] < 0) {
+                    metrics.recordFirstRun(processes, processIndex, currentTime);
+                }
+                cpuSlice.migrated = lastCpu[processIndex] >= 0 && lastCpu[processIndex] != cpu;
+                if(cpuSlice.migrated) {
+                    migrations++;
+                }
+                lastCpu[processIndex] = cpu;
+                busyTime[cpu] += ticks;
+
+                processes.timeScheduled[processIndex] += ticks;  // The process was scheduled for more time units
+                // Mark a process as done when its required computation time equals its time spent running on the CPU
+                if(!cpuSlice.overran && processes.totalTimeNeeded[processIndex] == processes.timeScheduled[processIndex]) {
+                    processes.markDone(processIndex, currentTime + ticks - 1);
+                    metrics.recordFinish(processes, processIndex, bursts ? bursts->getTimeBlocked(processIndex) : 0);
+                    cpuSlice.finished = true;
+                    processesRemaining--;
+                    if(queueMode == PER_CPU_QUEUES) {
+                        queueLength[owner[processIndex]]--;
+                    }
+                }
+
+                // A process at the end of its CPU burst moves on to its next burst, leaving the CPU if it is I/O
+                if(bursts && !cpuSlice.overran && bursts->processRan(processIndex, currentTime + ticks, processes)) {
+                    cpuSlice.blocked = true;
+                    if(queueMode == PER_CPU_QUEUES) {
+                        queueLength[owner[processIndex]]--;
+                    }
+                }
+            } else {
+                timesIdle += ticks;  // CPU is idle; no currently running process
+            }
+        }
+
+        complete = processesRemaining == 0;
+        currentTime += complete ? ticks - 1 : ticks;  // the clock stops on the last time step
+
+        return slice;
+    }
+
+private:
+
+    vector<SchedulerType*> schedulers;  // the scheduling algorithm, or one per CPU with PER_CPU_QUEUES
+
+    // Whether the scheduler type is final and keeps Scheduler's default runOnCpu() or fastForwardOnCpu(), which
+    // only forward to run() and fastForward() through a virtual call
+    static constexpr bool USES_DEFAULT_RUN_ON_CPU = is_final_v<SchedulerType>
+            && is_same_v<decltype(&SchedulerType::runOnCpu), decltype(&Scheduler::runOnCpu)>;
+    static constexpr bool USES_DEFAULT_FAST_FORWARD_ON_CPU = is_final_v<SchedulerType>
+            && is_same_v<decltype(&SchedulerType::fastForwardOnCpu), decltype(&Scheduler::fastForwardOnCpu)>;
+
+    /**
+     * Calls the scheduler's runOnCpu(), or its run() straight away where runOnCpu() would only forward to it,
+     * so that the call is resolved at compile time
+     */
+    static int runOnCpu(SchedulerType* scheduler, int cpu, int currentProcess, int currentTime, ProcessTable& processes) {
+        if constexpr(USES_DEFAULT_RUN_ON_CPU) {
+            return scheduler->run(currentProcess, currentTime, processes);
+        } else {
+            return scheduler->runOnCpu(cpu, currentProcess, currentTime, processes);
+        }
+    }
+
+    /**
+     * Calls the scheduler's fastForwardOnCpu(), or its fastForward() straight away where fastForwardOnCpu() would
+     * only forward to it, so that the call is resolved at compile time
+     */
+    static int fastForwardOnCpu(SchedulerType* scheduler, int cpu, int currentProcess, int currentTime, int maxTicks,
+                                ProcessTable& processes) {
+        if constexpr(USES_DEFAULT_FAST_FORWARD_ON_CPU) {
+            return scheduler->fastForward(currentProcess, currentTime, maxTicks, processes);
+        } else {
+            return scheduler->fastForwardOnCpu(cpu, currentProcess, currentTime, maxTicks, processes);
+        }
+    }
+
+    /**
+     * Hands a newly arrived process to the shared scheduler, or to the CPU with the shortest run queue
+     * @param processIndex The index of the process that arrived
+     */
+    void enqueue(int processIndex) {
+
+        if(queueMode == GLOBAL_QUEUE) {
+            schedulers[0]->processArrived(processIndex, processes);
+            return;
+        }
+
+        int cpu = static_cast<int>(min_element(queueLength.begin(), queueLength.end()) - queueLength.begin());
+        owner[processIndex] = cpu;
+        queueLength[cpu]++;
+        schedulers[cpu]->processArrived(processIndex, processes);
+    }
+
+    /**
+     * Moves a waiting process from the CPU with the most waiting processes to an idle CPU
+     * @param thief The idle CPU
+     * @return Whether a process was moved
+     */
+    bool stealFor(int thief) {
+
+        // find the run queue with the most processes waiting, not counting the one on its CPU
+        int victim = -1;
+        int mostWaiting = 0;
+        for(int cpu = 0; cpu < numCpus; cpu++) {
+            int waiting = queueLength[cpu] - (isRunning(running[cpu]) ? 1 : 0);
+            if(cpu != thief && waiting > mostWaiting) {
+                victim = cpu;
+                mostWaiting = waiting;
+            }
+        }
+        if(victim < 0) {
+            return false;
+        }
+
+        int processIndex = schedulers[victim]->steal(currentTime, processes);
+        if(processIndex < 0) {
+            return false;
+        }
+
+        queueLength[victim]--;
+        queueLength[thief]++;
+        owner[processIndex] = thief;
+        schedulers[thief]->processArrived(processIndex, processes);
+        return true;
+    }
+
+};
+
+using Simulator = BasicSimulator<Scheduler>;  // a simulation of any scheduler, through its virtual methods
+
+#endif //SIMULATOR_H
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+#include "sweep.h"
+#include "flag_parsing.h"
+#include "parallel.h"
+#include "scheduler_dispatch.h"
+#include "simulator.h"
+
+using namespace std;
+
+/**
+ * Runs every compatible scheduler on every workload file at the same time and prints one comparison table
+ * Each simulation works on its own copy of the workload, since schedulers and the simulator modify it, but
+ * they share the workload's arrival calendar
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return 0 if the sweep is successful
+ */
+int runSweep(int argc, char* argv[]) {
+
+    vector<string> filenames;
+    ProcessType processType = NONE;  // NONE means the type is detected for each file
+    unsigned int numThreads = defaultThreadCount();
+    int timeQuantum = 10;
+    int numCpus = 1;
+    QueueMode queueMode = GLOBAL_QUEUE;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--sweep") {
+            continue;
+        } else if(argument == "--help") {
+            outputSweepUsage(cout);
+            exit(0);
+        } else if(argument.rfind("--", 0) != 0) {
+            findWorkloadFiles(argument, filenames);
+            continue;
+        }
+
+        // every remaining flag takes a value
+        if(i + 1 >= argc) {
+            cerr << "Missing value for " << argument << endl;
+            outputSweepUsage(cerr);
+            exit(-1);
+        }
+        string value = argv[++i];
+
+        if(argument == "--type") {
+            processType = processTypeFromName(value);
+            if(processType == NONE) {
+                cerr << "Invalid process type \"" << value << "\"" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--threads") {
+            numThreads = max(1, parseIntegerFlag(argument, value));
+        } else if(argument == "--quantum") {
+            timeQuantum = parseIntegerFlag(argument, value);
+            if(timeQuantum < 1) {
+                cerr << "The time quantum must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--cpus") {
+            numCpus = parseIntegerFlag(argument, value);
+            if(numCpus < 1) {
+                cerr << "The number of CPUs must be at least 1" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--queues") {
+            if(!queueModeFromName(value, queueMode)) {
+                cerr << "Invalid queue mode \"" << value << "\"" << endl;
+                exit(-1);
+            }
+        } else {
+            cerr << "Unknown flag " << argument << endl;
+            outputSweepUsage(cerr);
+            exit(-1);
+        }
+    }
+
+    if(filenames.empty()) {
+        cerr << "Did not specify any process files" << endl;
+        outputSweepUsage(cerr);
+        exit(-1);
+    }
+
+    // Read every workload once; the simulations copy them
+    vector<SweepWorkload> workloads(filenames.size());
+    parallelFor(workloads.size(), numThreads, [&](unsigned int w) {
+        workloads[w].filename = filenames[w];
+        workloads[w].processType = processType != NONE ? processType : detectProcessType(filenames[w]);
+        readProcessFile(filenames[w], workloads[w].processType, workloads[w].processes);
+        workloads[w].arrivals = make_shared<ArrivalCalendar>(workloads[w].processes);
+    });
+
+    // One job per compatible scheduler for every workload
+    vector<SweepJob> jobs;
+    for(unsigned int w = 0; w < workloads.size(); w++) {
+        for(unsigned int s = 1; s <= schedulerNames(workloads[w].processType).size(); s++) {
+            SweepJob job;
+            job.workload = w;
+            job.schedulerType = s;
+            jobs.push_back(job);
+        }
+    }
+
+    parallelFor(jobs.size(), numThreads, [&](unsigned int j) {
+        SweepJob& job = jobs[j];
+        const SweepWorkload& workload = workloads[job.workload];
+
+        ProcessTable processes = workload.processes;  // schedulers modify the table, so each job gets a copy
+        vector<Scheduler*> schedulingAlgorithms = createSchedulers(workload.processType, job.schedulerType, processes,
+                                                                   timeQuantum, numCpus, queueMode);
+
+        job.statistics = visitSchedulers(workload.processType, job.schedulerType, schedulingAlgorithms,
+                                         [&](const auto& schedulers) {
+            BasicSimulator simulator(schedulers, processes, numCpus, queueMode, workload.arrivals);
+            while(!simulator.isComplete()) {
+                simulator.step();
+            }
+            return computeStatistics(processes, workload.processType, simulator);
+        });
+        for(Scheduler* schedulingAlgorithm : schedulingAlgorithms) {
+            delete schedulingAlgorithm;
+        }
+    });
+
+    outputSweepTable(cout, workloads, jobs);
+
+    return 0;
+}
+
+/**
+ * Print how to run the program in sweep mode
+ * @param out The stream to write the usage to
+ */
+void outputSweepUsage(ostream& out) {
+    out << "Usage: program --sweep [options] path..." << endl;
+    out << "  path                   a process file, or a directory to search for .txt and .bin process files" << endl;
+    out << "  --type TYPE            treat every file as batch, interactive, or realtime (default: detect per file)" << endl;
+    out << "  --threads N            number of simulations to run at once (default " << defaultThreadCount() << ")" << endl;
+    out << "  --quantum N            time quantum for rr and ml, and for the top level of mlf (default 10)" << endl;
+    out << "  --cpus N               number of CPUs to simulate (default 1)" << endl;
+    out << "  --queues MODE          global (default) or per-cpu run queues with work stealing" << endl;
+}
+
+/**
+ * Collect the process files at a path
+ * @param path A process file, or a directory that is searched recursively for .txt and .bin files
+ * @param filenames The list to add the files to, sorted within a directory
+ */
+void findWorkloadFiles(const string& path, vector<string>& filenames) {
+
+    if(!filesystem::is_directory(path)) {
+        filenames.push_back(path);
+        return;
+    }
+
+    vector<string> found;
+    for(const filesystem::directory_entry& entry : filesystem::recursive_directory_iterator(path)) {
+        if(entry.is_regular_file() && (entry.path().extension() == ".txt" || entry.path().extension() == ".bin")) {
+            found.push_back(entry.path().string());
+        }
+    }
+    sort(found.begin(), found.end());
+    filenames.insert(filenames.end(), found.begin(), found.end());
+}
+
+/**
+ * Print the results of a sweep as one table, with a row for every scheduler run on every workload
+ * Simulations on several CPUs add the mean CPU utilization and the number of migrations
+ * @param out The stream to write the table to
+ * @param workloads The workloads of the sweep
+ * @param jobs The finished simulations, grouped by workload
+ */
+void outputSweepTable(ostream& out, const vector<SweepWorkload>& workloads, const vector<SweepJob>& jobs) {
+
+    unsigned int fileWidth = 4;
+    for(unsigned int w = 0; w < workloads.size(); w++) {
+        fileWidth = max(fileWidth, static_cast<unsigned int>(workloads[w].filename.size()));
+    }
+
+    bool multicore = !jobs.empty() && jobs[0].statistics.numCpus > 1;
+
+    string separator = string(fileWidth + 1, '-') + "+-------------+-----------+------------+-----------------------+--------+-----------------+";
+    if(multicore) {
+        separator += "------------+------------+";
+    }
+
+    out << left << setw(fileWidth) << "File" << right
+        << " | Type        | Scheduler | Turnaround | Normalized Turnaround | Idle % | Deadlines Met % |";
+    if(multicore) {
+        out << " CPU Util % | Migrations |";
+    }
+    out << endl;
+    out << separator << endl;
+
+    out << fixed << setprecision(2);
+    for(unsigned int j = 0; j < jobs.size(); j++) {
+        const SweepWorkload& workload = workloads[jobs[j].workload];
+        const RunStatistics& statistics = jobs[j].statistics;
+
+        out << left << setw(fileWidth) << workload.filename;
+        out << " | " << setw(11) << processTypeName(workload.processType);
+        out << " | " << setw(9) << schedulerNames(workload.processType).at(jobs[j].schedulerType - 1) << right;
+        out << " | " << setw(10) << statistics.meanTurnaroundTime;
+        out << " | " << setw(21) << statistics.meanNormalizedTurnaroundTime;
+        out << " | " << setw(6) << statistics.idlePercentage;
+        if(workload.processType == REALTIME) {
+            out << " | " << setw(15) << statistics.metDeadlinesPercentage << " |";
+        } else {
+            out << " | " << setw(15) << "-" << " |";
+        }
+        if(multicore) {
+            double utilizationSum = 0;
+            for(double utilization : statistics.cpuUtilization) {
+                utilizationSum += utilization;
+            }
+            out << " " << setw(10) << utilizationSum / statistics.numCpus << " | " << setw(10) << statistics.migrations << " |";
+        }
+        out << endl;
+    }
+}
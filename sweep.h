@@ -0,0 +1,39 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "arrival_calendar.h"
+#include "main.h"
+#include "process_table.h"
+
+using namespace std;
+
+/**
+ * Data structure for one simulation in a sweep: one scheduler run on one workload file
+ */
+struct SweepJob {
+    unsigned int workload = 0;  // index of the workload file the job simulates
+    int schedulerType = -1;  // the number of the scheduling algorithm, as listed by promptForSchedulingAlgorithm
+    RunStatistics statistics;  // the results of the simulation
+};
+
+/**
+ * Data structure for a workload file in a sweep
+ */
+struct SweepWorkload {
+    string filename;  // the file containing the list of processes
+    ProcessType processType = NONE;  // the type of processes in the file
+    ProcessTable processes;  // the processes as read from the file, before any simulation
+    shared_ptr<const ArrivalCalendar> arrivals;  // the arrival calendar shared by every simulation of the workload
+};
+
+int runSweep(int argc, char* argv[]);
+void outputSweepUsage(ostream& out);
+void findWorkloadFiles(const string& path, vector<string>& filenames);
+void outputSweepTable(ostream& out, const vector<SweepWorkload>& workloads, const vector<SweepJob>& jobs);
+
+#endif //SWEEP_H
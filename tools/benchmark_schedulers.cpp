@@ -0,0 +1,504 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../flag_parsing.h"
+#include "../process.h"
+#include "../process_table.h"
+#include "../scheduler.h"
+#include "../scheduler_dispatch.h"
+#include "../simulator.h"
+
+using namespace std;
+
+/**
+ * Microbenchmark of how fast each scheduler makes decisions, as a function of how many processes are waiting
+ * A decision is one step of a busy CPU: the running process finishes, the scheduler's run() picks the next
+ * one, and the finished process is replaced by a newly arrived one, so the number of waiting processes stays
+ * the same for the whole measurement
+ * With --simulate, whole simulations of generated workloads are also timed per simulator step
+ * Every measurement is made both through the scheduler's virtual methods and with the loop compiled for the
+ * scheduler's concrete type, and is warmed up and then repeated; the results are written as JSON
+ */
+
+/**
+ * Ways of calling the scheduler from the measured loop
+ */
+enum Dispatch {
+    VIRTUAL_DISPATCH,  // through a Scheduler pointer and its virtual methods
+    STATIC_DISPATCH  // through a pointer to the concrete (final) scheduler class
+};
+
+/**
+ * Options for a benchmark run, taken from command-line flags
+ */
+struct BenchmarkOptions {
+    vector<string> schedulers = {"fifo", "spn", "srt", "hrrn", "rr", "ml", "mlf", "rm", "edf"};  // what to measure
+    vector<int> sizes = {10, 100, 1000, 10000, 100000, 1000000};  // the numbers of waiting processes
+    vector<Dispatch> dispatches = {VIRTUAL_DISPATCH, STATIC_DISPATCH};  // how to call the schedulers
+    bool simulate = false;  // whether to also time whole simulations
+    int repetitions = 5;  // timed batches per measurement
+    int minTime = 50;  // the shortest a timed batch may take, in milliseconds
+    uint64_t seed = 1;  // seed for the random workloads
+    int timeQuantum = 10;  // the time quantum for RR, ML, and MLF
+    string outputFilename;  // where to write the results, or empty for standard output
+};
+
+/**
+ * Data structure for the result of one measurement
+ */
+struct BenchmarkResult {
+    string scheduler;  // the abbreviation of the scheduler
+    Dispatch dispatch = VIRTUAL_DISPATCH;  // how the scheduler was called
+    int size = 0;  // the number of waiting processes, or of processes in a simulation
+    long long operations = 0;  // the number of timed decisions or simulator steps, over every repetition
+    double medianNanoseconds = 0;  // the median over the repetitions of the time per operation
+    double minNanoseconds = 0;  // the fastest repetition's time per operation
+};
+
+/**
+ * Draws random process attributes from a seeded generator, so every scheduler sees the same workload
+ */
+class AttributeSource {
+
+public:
+
+    explicit AttributeSource(uint64_t seed) : engine(seed) {}
+
+    /**
+     * @return A number drawn uniformly from low to high, inclusive
+     */
+    int draw(int low, int high) {
+        return low + static_cast<int>(engine() % static_cast<uint64_t>(high - low + 1));
+    }
+
+    /**
+     * Gives a row of a table the attributes of a process that arrives at a given time
+     * @param processes The table of processes
+     * @param index The row
+     * @param time The time the process arrives
+     */
+    void fill(ProcessTable& processes, int index, int time) {
+        processes.arrivalTime[index] = time;
+        processes.timeScheduled[index] = 0;
+        processes.totalTimeNeeded[index] = draw(1, 1000);
+        processes.timeFinished[index] = -1;
+        processes.flags[index] = 0;
+        if(processes.processType == INTERACTIVE) {
+            processes.priority[index] = draw(1, 5);
+        } else if(processes.processType == REALTIME) {
+            processes.period[index] = draw(10, 10000);
+            processes.deadline[index] = time + processes.period[index];  // jobs are due by their next release
+        }
+    }
+
+private:
+
+    mt19937_64 engine;  // produces the same sequence for a seed on every platform
+
+};
+
+/**
+ * @param name The abbreviation of a scheduler
+ * @return The type of processes the scheduler is benchmarked with, or NONE if the name is not recognized
+ */
+ProcessType processTypeFor(const string& name) {
+    if(name == "fifo" || name == "spn" || name == "srt" || name == "hrrn") {
+        return BATCH;
+    } else if(name == "rr" || name == "ml" || name == "mlf") {
+        return INTERACTIVE;
+    } else if(name == "rm" || name == "edf") {
+        return REALTIME;
+    }
+    return NONE;
+}
+
+/**
+ * @param name The abbreviation of a scheduler
+ * @return The number of the scheduler for its process type, as listed by promptForSchedulingAlgorithm
+ */
+int schedulerTypeFor(const string& name) {
+    if(name == "fifo" || name == "rr" || name == "rm") {
+        return 1;
+    } else if(name == "spn" || name == "ml" || name == "edf") {
+        return 2;
+    } else if(name == "srt" || name == "mlf") {
+        return 3;
+    }
+    return 4;
+}
+
+/**
+ * Create a scheduler, configured as the simulator configures it
+ * @param name The abbreviation of the scheduler
+ * @param timeQuantum The time quantum for RR, ML, and MLF
+ * @return The scheduler
+ */
+Scheduler* createScheduler(const string& name, int timeQuantum) {
+    if(name == "fifo") {
+        return new FirstInFirstOut;
+    } else if(name == "spn") {
+        return new ShortestProcessNext;
+    } else if(name == "srt") {
+        return new ShortestRemainingTime;
+    } else if(name == "hrrn") {
+        return new HighestResponseRatioNext;
+    } else if(name == "rr") {
+        return new RoundRobin(timeQuantum, timeQuantum);
+    } else if(name == "ml") {
+        return new Multilevel(timeQuantum);
+    } else if(name == "mlf") {
+        return new MultilevelFeedback(timeQuantum);
+    } else if(name == "rm") {
+        return new RateMonotonic;
+    }
+    return new EarliestDeadlineFirst;
+}
+
+/**
+ * Calls a function with a scheduler, as a Scheduler pointer or as a pointer to its concrete type
+ * @param name The abbreviation of the scheduler
+ * @param scheduler The scheduler
+ * @param dispatch How the function should see the scheduler
+ * @param function The function to call, with a vector holding the scheduler
+ * @return What the function returns
+ */
+template<class Function>
+auto withDispatch(const string& name, Scheduler* scheduler, Dispatch dispatch, Function&& function) {
+    if(dispatch == VIRTUAL_DISPATCH) {
+        return function(vector<Scheduler*>{scheduler});
+    }
+    return visitSchedulers(processTypeFor(name), schedulerTypeFor(name), {scheduler}, function);
+}
+
+/**
+ * Times an operation: the number of repetitions in a timed batch is doubled until a batch takes at least the
+ * minimum time, which also warms up the caches and data structures, and then the batch is timed repeatedly
+ * @param options The options for the run
+ * @param run Runs the operation a given number of times and returns how many operations it counted
+ * @param result Set to the number of operations and the time each took
+ */
+template<class Operation>
+void measure(const BenchmarkOptions& options, Operation&& run, BenchmarkResult& result) {
+
+    auto elapsed = [&](long long batch, long long& operations) {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        operations = run(batch);
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    };
+
+    long long batch = 1;
+    long long operations = 0;
+    while(elapsed(batch, operations) < options.minTime * 1e6) {
+        batch *= 2;
+    }
+
+    vector<double> nanoseconds;
+    result.operations = 0;
+    for(int repetition = 0; repetition < options.repetitions; repetition++) {
+        double time = elapsed(batch, operations);
+        nanoseconds.push_back(time / operations);
+        result.operations += operations;
+    }
+    sort(nanoseconds.begin(), nanoseconds.end());
+    result.medianNanoseconds = nanoseconds[nanoseconds.size() / 2];
+    result.minNanoseconds = nanoseconds.front();
+}
+
+/**
+ * Benchmark the decisions of one scheduler with one number of waiting processes
+ * Every process that finishes is replaced by a new one in its row, so the ready set keeps the same size
+ * @param name The abbreviation of the scheduler
+ * @param dispatch How to call the scheduler
+ * @param size The number of waiting processes
+ * @param options The options for the run
+ * @return The result of the measurement
+ */
+BenchmarkResult benchmarkDecisions(const string& name, Dispatch dispatch, int size, const BenchmarkOptions& options) {
+
+    AttributeSource source(options.seed);
+    ProcessTable processes(processTypeFor(name));
+    processes.resize(size);
+    for(int i = 0; i < size; i++) {
+        processes.idIndex[i] = processes.ids.add("P" + to_string(i + 1));
+        source.fill(processes, i, 0);
+        processes.markArrived(i);
+    }
+
+    Scheduler* scheduler = createScheduler(name, options.timeQuantum);
+    BenchmarkResult result;
+    result.scheduler = name;
+    result.dispatch = dispatch;
+    result.size = size;
+
+    withDispatch(name, scheduler, dispatch, [&](const auto& schedulers) {
+        auto* concrete = schedulers[0];
+        for(int i = 0; i < size; i++) {
+            concrete->processArrived(i, processes);
+        }
+
+        int currentTime = 0;
+        int current = concrete->run(-1, currentTime, processes);
+
+        // one decision: the running process finishes, the next one is chosen, and a new process arrives
+        measure(options, [&](long long decisions) {
+            for(long long d = 0; d < decisions; d++) {
+                int finished = current;
+                processes.timeScheduled[finished] = processes.totalTimeNeeded[finished];
+                processes.markDone(finished, currentTime);
+                currentTime++;
+                current = concrete->run(finished, currentTime, processes);
+                source.fill(processes, finished, currentTime);
+                processes.markArrived(finished);
+                concrete->processArrived(finished, processes);
+            }
+            return decisions;
+        }, result);
+    });
+
+    delete scheduler;
+    return result;
+}
+
+/**
+ * Benchmark whole simulations of one scheduler: a workload of processes arriving a little faster on average
+ * than the CPU can finish them is simulated to the end, and the time is counted per simulator step
+ * @param name The abbreviation of the scheduler
+ * @param dispatch How the simulator calls the scheduler
+ * @param size The number of processes in the workload
+ * @param options The options for the run
+ * @return The result of the measurement
+ */
+BenchmarkResult benchmarkSimulation(const string& name, Dispatch dispatch, int size, const BenchmarkOptions& options) {
+
+    AttributeSource source(options.seed);
+    ProcessTable workload(processTypeFor(name));
+    workload.resize(size);
+    int arrivalTime = 0;
+    for(int i = 0; i < size; i++) {
+        workload.idIndex[i] = workload.ids.add("P" + to_string(i + 1));
+        source.fill(workload, i, arrivalTime);
+        arrivalTime += source.draw(0, 1050);  // about 95% of the CPU's capacity
+    }
+    shared_ptr<const ArrivalCalendar> arrivals = make_shared<ArrivalCalendar>(workload);
+
+    BenchmarkResult result;
+    result.scheduler = name;
+    result.dispatch = dispatch;
+    result.size = size;
+
+    measure(options, [&](long long simulations) {
+        long long steps = 0;
+        for(long long s = 0; s < simulations; s++) {
+            ProcessTable processes = workload;
+            Scheduler* scheduler = createScheduler(name, options.timeQuantum);
+            steps += withDispatch(name, scheduler, dispatch, [&](const auto& schedulers) {
+                BasicSimulator simulator(schedulers, processes, 1, GLOBAL_QUEUE, arrivals);
+                long long count = 0;
+                while(!simulator.isComplete()) {
+                    simulator.step();
+                    count++;
+                }
+                return count;
+            });
+            delete scheduler;
+        }
+        return steps;
+    }, result);
+
+    return result;
+}
+
+/**
+ * Print how to run the benchmark
+ * @param out The stream to write the usage to
+ */
+void outputUsage(ostream& out) {
+    out << "Usage: benchmark_schedulers [options]" << endl;
+    out << "  --schedulers S1,S2,..    schedulers to measure (default fifo,spn,srt,hrrn,rr,ml,mlf,rm,edf)" << endl;
+    out << "  --sizes N1,N2,..         numbers of waiting processes (default 10,100,1000,10000,100000,1000000)" << endl;
+    out << "  --dispatch D1,D2,..      virtual and/or static calls to the schedulers (default virtual,static)" << endl;
+    out << "  --simulate               also time whole simulations, with the sizes as numbers of processes" << endl;
+    out << "  --repetitions N          timed batches per measurement (default 5)" << endl;
+    out << "  --min-time MS            shortest time of a timed batch, in milliseconds (default 50)" << endl;
+    out << "  --seed N                 random seed for the workloads (default 1)" << endl;
+    out << "  --quantum N              time quantum for rr, ml, and mlf (default 10)" << endl;
+    out << "  --output FILE            write the JSON results to FILE instead of standard output" << endl;
+}
+
+/**
+ * @param text A comma-separated list
+ * @return The items of the list
+ */
+vector<string> splitList(const string& text) {
+    vector<string> items;
+    stringstream in(text);
+    string item;
+    while(getline(in, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+/**
+ * Parse the command-line flags of the benchmark
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return The options for the run
+ */
+BenchmarkOptions parseOptions(int argc, char* argv[]) {
+
+    BenchmarkOptions options;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--help") {
+            outputUsage(cout);
+            exit(0);
+        } else if(argument == "--simulate") {
+            options.simulate = true;
+            continue;
+        }
+
+        // every other flag takes a value
+        if(i + 1 >= argc) {
+            cerr << "Missing value for " << argument << endl;
+            outputUsage(cerr);
+            exit(-1);
+        }
+        string value = argv[++i];
+
+        if(argument == "--schedulers") {
+            options.schedulers = splitList(value);
+        } else if(argument == "--sizes") {
+            options.sizes.clear();
+            for(const string& size : splitList(value)) {
+                options.sizes.push_back(parseIntegerFlag(argument, size));
+            }
+        } else if(argument == "--dispatch") {
+            options.dispatches.clear();
+            for(const string& dispatch : splitList(value)) {
+                if(dispatch != "virtual" && dispatch != "static") {
+                    cerr << "Invalid dispatch \"" << dispatch << "\"" << endl;
+                    exit(-1);
+                }
+                options.dispatches.push_back(dispatch == "virtual" ? VIRTUAL_DISPATCH : STATIC_DISPATCH);
+            }
+        } else if(argument == "--repetitions") {
+            options.repetitions = parseIntegerFlag(argument, value);
+        } else if(argument == "--min-time") {
+            options.minTime = parseIntegerFlag(argument, value);
+        } else if(argument == "--seed") {
+            options.seed = parseUnsignedFlag(argument, value);
+        } else if(argument == "--quantum") {
+            options.timeQuantum = parseIntegerFlag(argument, value);
+        } else if(argument == "--output") {
+            options.outputFilename = value;
+        } else {
+            cerr << "Unknown flag " << argument << endl;
+            outputUsage(cerr);
+            exit(-1);
+        }
+    }
+
+    for(const string& name : options.schedulers) {
+        if(processTypeFor(name) == NONE) {
+            cerr << "Unknown scheduler \"" << name << "\"" << endl;
+            exit(-1);
+        }
+    }
+    for(int size : options.sizes) {
+        if(size < 2) {
+            cerr << "Every size must be at least 2" << endl;
+            exit(-1);
+        }
+    }
+    if(options.dispatches.empty() || options.repetitions < 1 || options.minTime < 1 || options.timeQuantum < 1) {
+        cerr << "Specify a dispatch, and repetitions, a minimum time, and a time quantum of at least 1" << endl;
+        exit(-1);
+    }
+
+    return options;
+}
+
+/**
+ * Writes a list of results as the elements of a JSON array, closing the array
+ * @param out The stream to write the results to
+ * @param results The results
+ * @param sizeName The name of the size of a result
+ * @param operationName The name of what was timed, in the plural
+ * @param perOperation The name of one of what was timed, capitalized
+ */
+void outputResults(ostream& out, const vector<BenchmarkResult>& results, const string& sizeName,
+                   const string& operationName, const string& perOperation) {
+    for(unsigned int r = 0; r < results.size(); r++) {
+        const BenchmarkResult& result = results[r];
+        out << (r == 0 ? "" : ",") << "\n    {"
+            << "\"scheduler\": \"" << result.scheduler << "\", "
+            << "\"dispatch\": \"" << (result.dispatch == VIRTUAL_DISPATCH ? "virtual" : "static") << "\", "
+            << "\"" << sizeName << "\": " << result.size << ", "
+            << "\"" << operationName << "\": " << result.operations << ", "
+            << "\"nsPer" << perOperation << "\": " << result.medianNanoseconds << ", "
+            << "\"minNsPer" << perOperation << "\": " << result.minNanoseconds << ", "
+            << "\"" << operationName << "PerSecond\": " << 1e9 / result.medianNanoseconds << "}";
+    }
+    out << (results.empty() ? "]" : "\n  ]");
+}
+
+/**
+ * Measures the decision throughput of every scheduler and writes the results as JSON
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return 0 if the benchmark is successful
+ */
+int main(int argc, char* argv[]) {
+
+    BenchmarkOptions options = parseOptions(argc, argv);
+
+    ofstream file;
+    if(!options.outputFilename.empty()) {
+        file.open(options.outputFilename.c_str());
+        if(file.fail()) {
+            cerr << "Unable to open file \"" << options.outputFilename << "\", terminating program" << endl;
+            exit(-1);
+        }
+    }
+    ostream& out = file.is_open() ? file : cout;
+
+    vector<BenchmarkResult> decisions;
+    vector<BenchmarkResult> simulations;
+    for(const string& name : options.schedulers) {
+        for(int size : options.sizes) {
+            for(Dispatch dispatch : options.dispatches) {
+                decisions.push_back(benchmarkDecisions(name, dispatch, size, options));
+                if(options.simulate) {
+                    simulations.push_back(benchmarkSimulation(name, dispatch, size, options));
+                }
+            }
+        }
+    }
+
+    out << setprecision(3) << fixed;
+    out << "{" << endl;
+    out << "  \"repetitions\": " << options.repetitions << "," << endl;
+    out << "  \"minTimeMs\": " << options.minTime << "," << endl;
+    out << "  \"seed\": " << options.seed << "," << endl;
+    out << "  \"timeQuantum\": " << options.timeQuantum << "," << endl;
+    out << "  \"results\": [";
+    outputResults(out, decisions, "readySize", "decisions", "Decision");
+    if(options.simulate) {
+        out << "," << endl << "  \"simulations\": [";
+        outputResults(out, simulations, "numProcesses", "steps", "Step");
+    }
+    out << endl << "}" << endl;
+
+    return 0;
+}
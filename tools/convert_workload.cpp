@@ -0,0 +1,105 @@
+#include <climits>
+#include <iostream>
+#include <string>
+
+#include "../binary_workload.h"
+#include "../flag_parsing.h"
+#include "../process_file.h"
+#include "../sched_trace.h"
+
+using namespace std;
+
+/**
+ * Print how to run the converter
+ * @param out The stream to write the usage to
+ */
+void outputUsage(ostream& out) {
+    out << "Usage: convert_workload [--type TYPE] [--tick-us N] input output" << endl;
+    out << "  Converts a text process file to a binary workload, or a binary workload back to text" << endl;
+    out << "  The direction is chosen from the input; the process type of a text file is detected from" << endl;
+    out << "  its first process unless --type (batch, interactive, or realtime) is given" << endl;
+    out << "  A scheduler trace (perf sched script or ftrace sched_switch/sched_wakeup text) is converted to a" << endl;
+    out << "  text process file with one process per CPU burst, as interactive processes unless --type batch is" << endl;
+    out << "  given, counting time in steps of N microseconds (default " << DEFAULT_TRACE_TICK_NANOSECONDS / 1000 << ")" << endl;
+}
+
+/**
+ * Converts process files between the text and binary workload formats
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return 0 if the conversion is successful
+ */
+int main(int argc, char* argv[]) {
+
+    ProcessType processType = NONE;
+    TraceOptions traceOptions;
+    string filenames[2];
+    int numFilenames = 0;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--help") {
+            outputUsage(cout);
+            return 0;
+        } else if(argument == "--type" && i + 1 < argc) {
+            string name = argv[++i];
+            processType = name == "batch" ? BATCH : name == "interactive" ? INTERACTIVE : name == "realtime" ? REALTIME : NONE;
+            if(processType == NONE) {
+                cerr << "Invalid process type \"" << name << "\"" << endl;
+                exit(-1);
+            }
+        } else if(argument == "--tick-us" && i + 1 < argc) {
+            long long tickMicroseconds = parseLongFlag(argument, argv[++i]);
+            if(tickMicroseconds < 1) {
+                cerr << "The time step must be at least 1 microsecond" << endl;
+                exit(-1);
+            }
+            // bounded before the conversion to nanoseconds so that it cannot overflow
+            if(tickMicroseconds > LLONG_MAX / 1000) {
+                invalidFlagValue(argument);
+            }
+            traceOptions.tickNanoseconds = tickMicroseconds * 1000;
+        } else if(argument.rfind("--", 0) != 0 && numFilenames < 2) {
+            filenames[numFilenames++] = argument;
+        } else {
+            outputUsage(cerr);
+            exit(-1);
+        }
+    }
+
+    if(numFilenames != 2) {
+        outputUsage(cerr);
+        exit(-1);
+    }
+
+    if(processType == NONE) {
+        processType = detectProcessType(filenames[0]);
+    }
+
+    // Traces are streamed straight to the output, so they can be much larger than memory
+    if(isSchedTraceFile(filenames[0])) {
+        TraceSummary summary = convertSchedTrace(filenames[0], processType, filenames[1], traceOptions);
+        cout << "Converted " << summary.numJobs << " CPU bursts of " << summary.numThreads << " threads from "
+             << summary.numEvents << " scheduler events";
+        if(summary.numMalformed > 0) {
+            cout << " (skipped " << summary.numMalformed << " malformed event" << (summary.numMalformed == 1 ? "" : "s") << ")";
+        }
+        cout << endl;
+        return 0;
+    }
+
+    MappedFile input(filenames[0]);
+    bool toText = isBinaryWorkload(input.begin(), input.end());
+
+    ProcessTable processes;
+    readProcessFile(filenames[0], processType, processes);
+
+    if(toText) {
+        writeProcessFile(filenames[1], processes);
+    } else {
+        writeBinaryWorkload(filenames[1], processes);
+    }
+
+    return 0;
+}
@@ -0,0 +1,449 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../flag_parsing.h"
+
+using namespace std;
+
+/**
+ * Generator for large synthetic process files in the formats read by the simulator
+ * Processes are written as soon as they are generated, so memory use does not grow with the number of processes
+ * Every random number comes from a seeded mt19937_64 and is transformed with explicit formulas rather than the
+ * standard library distributions, whose output differs between implementations, so a seed produces the same
+ * file everywhere
+ */
+
+/**
+ * Options for a generated workload, taken from command-line flags
+ */
+struct GeneratorOptions {
+    string type = "batch";  // batch, interactive, or realtime
+    long long count = 1000;  // the number of processes to write
+    uint64_t seed = 1;  // seed for the random number generator
+    string outputFilename;  // where to write the processes, or empty for standard output
+
+    string arrivals = "poisson";  // poisson or bursty
+    double rate = 0.1;  // the mean number of arrivals per time unit
+    double burstSize = 20;  // the mean number of processes that arrive together in a bursty workload
+
+    string computation = "pareto";  // pareto or lognormal
+    double meanComputation = 10;  // the mean computation time
+    double paretoShape = 1.5;  // the tail index of the Pareto distribution (must be above 1 for a finite mean)
+    double lognormalSigma = 1.0;  // the standard deviation of the logarithm of the lognormal distribution
+    int maxComputation = 1000000;  // computation times are capped so they stay far from integer overflow
+
+    vector<double> priorityWeights = {1, 1, 1, 1, 1};  // relative weight of each interactive priority, 1 to 5
+
+    int tasks = 10;  // the number of periodic tasks in a realtime workload
+    double utilization = 0.7;  // the total utilization of the realtime tasks
+    int minPeriod = 10;  // the shortest period of a realtime task
+    int maxPeriod = 1000;  // the longest period of a realtime task
+};
+
+/**
+ * Source of reproducible random numbers
+ */
+class Random {
+
+public:
+
+    explicit Random(uint64_t seed) : engine(seed) {}
+
+    /**
+     * @return A uniformly distributed number in the open interval (0, 1)
+     */
+    double uniform() {
+        return ((engine() >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * @param mean The mean of the distribution
+     * @return An exponentially distributed number
+     */
+    double exponential(double mean) {
+        return -mean * log(uniform());
+    }
+
+    /**
+     * @return A normally distributed number with mean 0 and standard deviation 1 (Box-Muller transform)
+     */
+    double normal() {
+        // the two draws are taken in a fixed order, which a single expression would leave to the compiler
+        double radius = uniform();
+        double angle = uniform();
+        return sqrt(-2.0 * log(radius)) * cos(2.0 * M_PI * angle);
+    }
+
+    /**
+     * @param scale The smallest value of the distribution
+     * @param shape The tail index of the distribution
+     * @return A Pareto distributed number
+     */
+    double pareto(double scale, double shape) {
+        return scale / pow(uniform(), 1.0 / shape);
+    }
+
+    /**
+     * @param mu The mean of the logarithm of the distribution
+     * @param sigma The standard deviation of the logarithm of the distribution
+     * @return A lognormally distributed number
+     */
+    double lognormal(double mu, double sigma) {
+        return exp(mu + sigma * normal());
+    }
+
+private:
+
+    mt19937_64 engine;  // produces the same sequence for a seed on every platform
+
+};
+
+/**
+ * Data structure for a periodic realtime task, which releases one process every period
+ */
+struct PeriodicTask {
+    int period = 0;  // the time between releases, which is also the relative deadline
+    int computationTime = 0;  // the computation time of every released process
+    long long nextRelease = 0;  // the time of the next release
+    int index = 0;  // the position of the task, used to order simultaneous releases
+};
+
+/**
+ * Comparator that puts the task with the earliest next release at the top of a priority queue
+ */
+struct LaterRelease {
+    bool operator()(const PeriodicTask& a, const PeriodicTask& b) const {
+        return a.nextRelease > b.nextRelease || (a.nextRelease == b.nextRelease && a.index > b.index);
+    }
+};
+
+/**
+ * Print how to run the generator
+ * @param out The stream to write the usage to
+ */
+void outputUsage(ostream& out) {
+    out << "Usage: generate_workload [options]" << endl;
+    out << "  --type TYPE              batch, interactive, or realtime (default batch)" << endl;
+    out << "  --count N                number of processes (default 1000)" << endl;
+    out << "  --seed N                 random seed (default 1)" << endl;
+    out << "  --output FILE            write to FILE instead of standard output" << endl;
+    out << "  --arrivals MODEL         poisson or bursty (default poisson; batch and interactive)" << endl;
+    out << "  --rate R                 mean arrivals per time unit (default 0.1)" << endl;
+    out << "  --burst-size N           mean processes per burst for bursty arrivals (default 20)" << endl;
+    out << "  --computation DIST       pareto or lognormal (default pareto; batch and interactive)" << endl;
+    out << "  --mean-computation M     mean computation time (default 10)" << endl;
+    out << "  --pareto-shape A         Pareto tail index, above 1 (default 1.5)" << endl;
+    out << "  --lognormal-sigma S      lognormal shape (default 1)" << endl;
+    out << "  --max-computation N      cap on computation times (default 1000000)" << endl;
+    out << "  --priorities W1,..,W5    relative weights of priorities 1 to 5 (default 1,1,1,1,1)" << endl;
+    out << "  --tasks N                number of periodic realtime tasks (default 10)" << endl;
+    out << "  --utilization U          total utilization of the realtime tasks (default 0.7)" << endl;
+    out << "  --min-period N           shortest realtime period (default 10)" << endl;
+    out << "  --max-period N           longest realtime period (default 1000)" << endl;
+}
+
+/**
+ * Parse the comma-separated weights of the interactive priorities
+ * @param text The weights, one for each priority from 1 to 5
+ * @return The weights
+ */
+vector<double> parsePriorityWeights(const string& text) {
+
+    vector<double> weights;
+    stringstream in(text);
+    string weight;
+    double total = 0;
+
+    while(getline(in, weight, ',')) {
+        weights.push_back(parseDecimalFlag("--priorities", weight));
+        if(weights.back() < 0) {
+            cerr << "Priority weights cannot be negative" << endl;
+            exit(-1);
+        }
+        total += weights.back();
+    }
+
+    if(weights.size() != 5 || total <= 0) {
+        cerr << "--priorities takes five weights that do not sum to 0, one for each priority from 1 to 5" << endl;
+        exit(-1);
+    }
+
+    return weights;
+}
+
+/**
+ * Parse the command-line flags of the generator
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return The options for the workload
+ */
+GeneratorOptions parseOptions(int argc, char* argv[]) {
+
+    GeneratorOptions options;
+
+    for(int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if(argument == "--help") {
+            outputUsage(cout);
+            exit(0);
+        }
+
+        // every other flag takes a value
+        if(i + 1 >= argc) {
+            cerr << "Missing value for " << argument << endl;
+            outputUsage(cerr);
+            exit(-1);
+        }
+        string value = argv[++i];
+
+        if(argument == "--type") {
+            options.type = value;
+        } else if(argument == "--count") {
+            options.count = parseLongFlag(argument, value);
+        } else if(argument == "--seed") {
+            options.seed = parseUnsignedFlag(argument, value);
+        } else if(argument == "--output") {
+            options.outputFilename = value;
+        } else if(argument == "--arrivals") {
+            options.arrivals = value;
+        } else if(argument == "--rate") {
+            options.rate = parseDecimalFlag(argument, value);
+        } else if(argument == "--burst-size") {
+            options.burstSize = parseDecimalFlag(argument, value);
+        } else if(argument == "--computation") {
+            options.computation = value;
+        } else if(argument == "--mean-computation") {
+            options.meanComputation = parseDecimalFlag(argument, value);
+        } else if(argument == "--pareto-shape") {
+            options.paretoShape = parseDecimalFlag(argument, value);
+        } else if(argument == "--lognormal-sigma") {
+            options.lognormalSigma = parseDecimalFlag(argument, value);
+        } else if(argument == "--max-computation") {
+            options.maxComputation = parseIntegerFlag(argument, value);
+        } else if(argument == "--priorities") {
+            options.priorityWeights = parsePriorityWeights(value);
+        } else if(argument == "--tasks") {
+            options.tasks = parseIntegerFlag(argument, value);
+        } else if(argument == "--utilization") {
+            options.utilization = parseDecimalFlag(argument, value);
+        } else if(argument == "--min-period") {
+            options.minPeriod = parseIntegerFlag(argument, value);
+        } else if(argument == "--max-period") {
+            options.maxPeriod = parseIntegerFlag(argument, value);
+        } else {
+            cerr << "Unknown flag " << argument << endl;
+            outputUsage(cerr);
+            exit(-1);
+        }
+    }
+
+    // Reject options that would produce an unreadable or meaningless file
+    string error;
+    if(options.type != "batch" && options.type != "interactive" && options.type != "realtime") {
+        error = "--type must be batch, interactive, or realtime";
+    } else if(options.count < 0) {
+        error = "--count cannot be negative";
+    } else if(options.arrivals != "poisson" && options.arrivals != "bursty") {
+        error = "--arrivals must be poisson or bursty";
+    } else if(options.rate <= 0 || options.burstSize < 1) {
+        error = "--rate must be positive and --burst-size must be at least 1";
+    } else if(options.computation != "pareto" && options.computation != "lognormal") {
+        error = "--computation must be pareto or lognormal";
+    } else if(options.meanComputation < 1 || options.maxComputation < 1) {
+        error = "--mean-computation and --max-computation must be at least 1";
+    } else if(options.paretoShape <= 1 || options.lognormalSigma <= 0) {
+        error = "--pareto-shape must be above 1 and --lognormal-sigma must be positive";
+    } else if(options.tasks < 1 || options.utilization <= 0) {
+        error = "--tasks must be at least 1 and --utilization must be positive";
+    } else if(options.minPeriod < 1 || options.maxPeriod < options.minPeriod) {
+        error = "--min-period must be at least 1 and no more than --max-period";
+    }
+
+    if(!error.empty()) {
+        cerr << error << endl;
+        exit(-1);
+    }
+
+    return options;
+}
+
+/**
+ * Draw a computation time from the heavy-tailed distribution in the options
+ * Both distributions are parameterized so that their mean is the requested mean computation time
+ * @param random The source of random numbers
+ * @param options The options for the workload
+ * @return A computation time of at least 1
+ */
+int nextComputationTime(Random& random, const GeneratorOptions& options) {
+
+    double time;
+    if(options.computation == "pareto") {
+        double scale = options.meanComputation * (options.paretoShape - 1) / options.paretoShape;
+        time = random.pareto(scale, options.paretoShape);
+    } else {
+        double sigma = options.lognormalSigma;
+        time = random.lognormal(log(options.meanComputation) - sigma * sigma / 2, sigma);
+    }
+
+    return static_cast<int>(min<double>(max(1.0, round(time)), options.maxComputation));
+}
+
+/**
+ * Draw an interactive priority from the weights in the options
+ * @param random The source of random numbers
+ * @param cumulativeWeights The running totals of the priority weights
+ * @return A priority from 1 to 5
+ */
+int nextPriority(Random& random, const vector<double>& cumulativeWeights) {
+    double target = random.uniform() * cumulativeWeights.back();
+    int priority = 1;
+    while(priority < static_cast<int>(cumulativeWeights.size()) && cumulativeWeights[priority - 1] <= target) {
+        priority++;
+    }
+    return priority;
+}
+
+/**
+ * Write batch or interactive processes with Poisson or bursty arrivals
+ * Bursty arrivals release geometrically sized groups of processes at the same time, with exponential gaps
+ * between the groups chosen so that the long-run arrival rate matches the Poisson model
+ * @param out The stream to write the processes to
+ * @param random The source of random numbers
+ * @param options The options for the workload
+ */
+void generateArrivals(ostream& out, Random& random, const GeneratorOptions& options) {
+
+    bool interactive = options.type == "interactive";
+    bool bursty = options.arrivals == "bursty";
+
+    vector<double> cumulativeWeights = options.priorityWeights;
+    for(unsigned int i = 1; i < cumulativeWeights.size(); i++) {
+        cumulativeWeights[i] += cumulativeWeights[i - 1];
+    }
+
+    double clock = 0;  // the arrival time before rounding down
+    long long burstRemaining = 0;  // processes left in the current burst
+
+    for(long long i = 1; i <= options.count; i++) {
+        if(!bursty) {
+            clock += random.exponential(1.0 / options.rate);
+        } else if(burstRemaining == 0) {
+            clock += random.exponential(options.burstSize / options.rate);
+            // geometric burst size with the requested mean
+            burstRemaining = 1 + static_cast<long long>(floor(log(random.uniform()) / log(1.0 - 1.0 / options.burstSize)));
+        }
+        if(bursty) {
+            burstRemaining--;
+        }
+
+        if(clock > 2000000000.0) {
+            cerr << "Arrival times overflow; use a higher --rate or a lower --count" << endl;
+            exit(-1);
+        }
+
+        out << 'P' << i << ' ' << static_cast<int>(clock) << ' ' << nextComputationTime(random, options);
+        if(interactive) {
+            out << ' ' << nextPriority(random, cumulativeWeights);
+        }
+        out << '\n';
+    }
+}
+
+/**
+ * Write the processes released by a set of periodic realtime tasks
+ * Task utilizations are drawn with UUniFast so that they sum to the requested total, periods are drawn
+ * log-uniformly, and each task releases a process every period with a deadline at the end of that period
+ * Only one pending release per task is kept, so memory use depends on the number of tasks, not processes
+ * @param out The stream to write the processes to
+ * @param random The source of random numbers
+ * @param options The options for the workload
+ */
+void generatePeriodicTasks(ostream& out, Random& random, const GeneratorOptions& options) {
+
+    priority_queue<PeriodicTask, vector<PeriodicTask>, LaterRelease> releases;
+    double sumUtilization = options.utilization;
+
+    for(int k = 0; k < options.tasks; k++) {
+        // UUniFast: split the remaining utilization between this task and the tasks after it
+        double taskUtilization = sumUtilization;
+        if(k < options.tasks - 1) {
+            double nextSumUtilization = sumUtilization * pow(random.uniform(), 1.0 / (options.tasks - k - 1));
+            taskUtilization = sumUtilization - nextSumUtilization;
+            sumUtilization = nextSumUtilization;
+        }
+
+        PeriodicTask task;
+        task.index = k;
+        task.period = static_cast<int>(round(exp(log(options.minPeriod)
+                + random.uniform() * (log(options.maxPeriod) - log(options.minPeriod)))));
+        task.computationTime = max(1, static_cast<int>(round(taskUtilization * task.period)));
+        releases.push(task);
+    }
+
+    for(long long i = 1; i <= options.count; i++) {
+        PeriodicTask task = releases.top();
+        releases.pop();
+
+        long long deadline = task.nextRelease + task.period;
+        if(deadline > 2000000000LL) {
+            cerr << "Deadlines overflow; use fewer processes or shorter periods" << endl;
+            exit(-1);
+        }
+
+        out << 'P' << i << ' ' << task.nextRelease << ' ' << task.computationTime << ' '
+            << task.period << ' ' << deadline << '\n';
+
+        task.nextRelease = deadline;
+        releases.push(task);
+    }
+}
+
+/**
+ * Runs the workload generator
+ * @param argc The number of provided command-line arguments
+ * @param argv The list of provided command-line arguments
+ * @return 0 if the workload was written successfully
+ */
+int main(int argc, char* argv[]) {
+
+    GeneratorOptions options = parseOptions(argc, argv);
+    Random random(options.seed);
+
+    ofstream file;
+    vector<char> buffer(1 << 20);  // large writes keep the output from dominating the run time
+    if(!options.outputFilename.empty()) {
+        file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+        file.open(options.outputFilename.c_str());
+        if(file.fail()) {
+            cerr << "Unable to open file \"" << options.outputFilename << "\", terminating program" << endl;
+            exit(-1);
+        }
+    } else {
+        ios::sync_with_stdio(false);
+    }
+    ostream& out = options.outputFilename.empty() ? cout : file;
+
+    out << options.count << '\n';
+    if(options.type == "realtime") {
+        generatePeriodicTasks(out, random, options);
+    } else {
+        generateArrivals(out, random, options);
+    }
+
+    out.flush();
+    if(out.fail()) {
+        cerr << "Failed to write the workload" << endl;
+        exit(-1);
+    }
+
+    return 0;
+}